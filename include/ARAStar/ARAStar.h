@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include "../Common/ISingleAgentPathFinder.h"
+#include "../AStar/AStar.h"
+
+class Agent;
+class Map;
+
+/*
+ * Anytime Repairing A* (Likhachev et al., 2003). A first path is found quickly by weighted A* under a large factor
+ * w, which is then lowered step by step down to 1, each step improving the path, until the deadline passes.
+ * The nodes, g-values and parents of a query, kept in the same grid-indexed store as AStar, persist across the
+ * steps: a closed node reached by a cheaper path is set aside in an inconsistent list instead of being expanded
+ * again within the step, and only the open and inconsistent nodes are queued again under the next factor.
+ * Each path found is reported with its proven bound, its cost over the least f-value of the open and inconsistent
+ * nodes, no greater than w. The heuristic must be consistent.
+ */
+class ARAStar : public ISingleAgentPathFinder
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    AStar::Store Lookup; // StaticValue of a node holds its key, g + w * h under the factor of the current step
+    quaternary_heap_t OpenSet;
+    std::vector<CellId> Inconsistent; // cells whose node has InconsistentStatus
+    std::vector<CellId> Closed; // cells expanded during the current step
+    double InitialSuboptimality, SuboptimalityStep;
+    Clock::duration TimeBudget; // deadline of Solve() and SolveFullReport(const Agent&), from the start of a query
+    double Suboptimality; // w of the current step
+    double AchievedBound; // of the best path found so far, 0 if none
+
+    bool IsDeadlinePassed(const Clock::time_point) const;
+    template<typename Model>
+    void Generate(AStarNode*, const Coordinate&, const CellId, const Coordinate&, const Coordinate&, const Model&);
+    template<typename Model> void Expand(AStarNode*, const Coordinate&, const Model&);
+    template<typename Model> bool ImprovePath(const CellId, const Coordinate&, const Clock::time_point, const Model&);
+    template<typename Model> double Requeue(const Coordinate&, const double, const Model&);
+    template<typename Model> Path Search(const Agent&, const Clock::time_point, const Model&);
+    Path ReconstructPath(const Agent&);
+
+public:
+    ARAStar(const Heuristic = Euclidean, const Weight = UnitWeight);
+    ARAStar(const Map*, const Heuristic = Euclidean, const Weight = UnitWeight);
+    ARAStar(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
+    virtual ~ARAStar() = default;
+    // the factor of the first step, lowered by the given amount after each path found, down to 1
+    void SetSuboptimalitySchedule(const double = 3, const double = 0.5);
+    void SetTimeBudget(const Clock::duration = std::chrono::milliseconds(20));
+    Path Solve(const Agent&) override;
+    Report SolveFullReport(const Agent&) override;
+    // best path found before the deadline, empty if none, together with its bound
+    Report SolveFullReport(const Agent&, const Clock::time_point);
+};
@@ -2,7 +2,7 @@
 
 #include "../Common/ISingleAgentPathFinder.h"
 #include "AStarNode.h"
-#include <unordered_map>
+#include "../Common/SearchState.h"
 
 class Agent;
 class Map;
@@ -10,24 +10,28 @@ class Map;
 class AStar : public ISingleAgentPathFinder
 {
 public:
-    using HashMap = std::unordered_map<Coordinate, AStarNode, CoordinateHasher>;
+    using Store = SearchState<AStarNode>;
 
 private:
     // open_set contains pointers to AStarNode in the Lookup table
-    HashMap Lookup;
+    Store Lookup;
+    OpenListType OpenList;
 
-    bool IsNodeExpanded(const Coordinate&);
-    bool IsLegalSuccessor(const Coordinate&);
-    void Expand(AStarNode*, const Coordinate&, heap_t&);
-    void Generate(AStarNode*, const Coordinate&, const Coordinate&, heap_t&);
+    bool IsNodeExpanded(const CellId);
+    bool IsLegalSuccessor(const CellId);
+    template<typename OpenSet, typename Model> void Expand(AStarNode*, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model>
+    void Generate(AStarNode*, const Coordinate&, const CellId, const Coordinate&, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model> bool Search(const Coordinate, const Coordinate&, const Model&);
     bool Search(const Coordinate, const Coordinate&);
     Path ReconstructPath(const Agent&);
 
 public:
-    AStar(const Heuristic = Euclidean);
-    AStar(Map*, const Heuristic = Euclidean);
-    AStar(Map*, const HeuristicFunction&, const WeightFunction&);
+    AStar(const Heuristic = Euclidean, const Weight = UnitWeight);
+    AStar(const Map*, const Heuristic = Euclidean, const Weight = UnitWeight);
+    AStar(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
     virtual ~AStar() = default;
+    void SetOpenList(const OpenListType);
     Path Solve(const Agent&) override;
     Report SolveFullReport(const Agent&) override;
 };
\ No newline at end of file
@@ -1,36 +1,35 @@
 #pragma once
 
 #include "../Common/Coordinate.h"
-#include <boost/heap/fibonacci_heap.hpp>
+#include "../Common/OpenList.h"
 
 class AStarNode;
 struct AStarNodeComparator
 {
     bool operator() (const AStarNode*, const AStarNode*) const;
 };
-using heap_t = boost::heap::fibonacci_heap<AStarNode*, boost::heap::compare<AStarNodeComparator>>;
+// breaks f-ties toward the larger g-value, see DeepTieBreak
+struct DeepAStarNodeComparator
+{
+    bool operator() (const AStarNode*, const AStarNode*) const;
+};
+using quaternary_heap_t = DaryHeap<AStarNode, AStarNodeComparator, 4>;
+using fibonacci_heap_t = FibonacciHeap<AStarNode, AStarNodeComparator>;
+using deep_quaternary_heap_t = DaryHeap<AStarNode, DeepAStarNodeComparator, 4>;
+using deep_fibonacci_heap_t = FibonacciHeap<AStarNode, DeepAStarNodeComparator>;
+using bucket_queue_t = BucketQueue<AStarNode, false>;
+using integral_bucket_queue_t = BucketQueue<AStarNode, true>;
 
+// fields of a node read by the open-set. the cell, parent and status of a node are kept by SearchState
 class AStarNode
 {
 public:
-    Coordinate MyCoordinate, Parent;
     double StaticValue; // f-value, estimated cost of the cheapest path (root..AStarNode..goal)
     double SumOfWeights; // g-value, the cheapest sum of weights to reach this AStarNode
-    bool IsGenerated; // whether this AStarNode has been created, inserted to open-set but not yet expanded
-    bool IsExpanded; // whether this AStarNode is already being popped from open set (=belongs to close-set)
-    heap_t::handle_type HeapPointer; // pointer to AStarNode in open-set. used for decrease key operation.
+    std::uint32_t HeapIndex; // position of AStarNode in open-set. used for decrease key operation.
 
     AStarNode();
-    AStarNode(const Coordinate&);
-    AStarNode(const Coordinate&, const double, const double);
-    AStarNode(const Coordinate&, const Coordinate&, const double, const double);
-    AStarNode(const AStarNode&);
-    AStarNode(AStarNode&&) noexcept ;
-    virtual ~AStarNode() = default;
+    AStarNode(const double, const double);
 
     friend std::ostream& operator<<(std::ostream&, const AStarNode&);
-    AStarNode& operator = (const AStarNode&);
-    AStarNode& operator = (AStarNode&&) noexcept ;
-    bool operator == (const AStarNode&) const;
-    bool operator != (const AStarNode&) const;
 };
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstddef>
+#include "../Common/Agent.h"
+#include "../Common/ISingleAgentPathFinder.h"
+#include "../AStar/AStar.h"
+
+class Map;
+
+// outcome of comparing the cost of a path against the cheapest one, found by a reference A* under the same weight.
+// the optimal lengths listed by scenarios cannot serve, since scenarios forbid cutting corners while Map allows it
+typedef enum Validation
+{
+    Unchecked, // the reference found no path
+    Optimal,
+    Shorter, // cheaper than the cheapest path, hence not a valid path
+    Longer,
+    Unsolved // no path was found
+}Validation;
+
+struct QueryRecord
+{
+    std::size_t Bucket = 0, Index = 0; // position of the task within its bucket
+    Agent Task{};
+    double WallTime = 0; // median over the repetitions, in milliseconds
+    double Cost = 0; // of the path under the weight of the solver, 0 if no path was found
+    double OptimalCost = 0; // of the path of the reference, 0 if it found none
+    double OctileLength = 0; // of the path, comparable to the optimal length of the scenario
+    unsigned int NumberOfExpandedNodes = 0, NumberOfGeneratedNodes = 0, NumberOfPopOperations = 0;
+    unsigned long MaxHeapSize = 0;
+    double Bound = 0; // suboptimality bound proven by the solver, infinity if none, 0 if no path was found
+    Validation Status = Unchecked;
+};
+
+struct Percentiles
+{
+    double Mean = 0, P50 = 0, P95 = 0, P99 = 0;
+};
+
+struct BucketSummary
+{
+    std::string Bucket{}; // its number, or "all" for the summary of every query
+    std::size_t NumberOfQueries = 0, NumberOfSolved = 0;
+    std::size_t NumberOfOptimal = 0, NumberOfShorter = 0, NumberOfLonger = 0, NumberOfUnsolved = 0;
+    Percentiles WallTime{}, ExpandedNodes{}, GeneratedNodes{}, PopOperations{};
+    unsigned long MaxHeapSize = 0;
+};
+
+/*
+ * Times a solver over every task of a scenario. Each query is solved a number of warmup times and then timed over
+ * a number of repetitions, nothing is printed meanwhile. Counters are taken from the report of the last repetition.
+ * Results are written as CSV or JSON, per query or as per-bucket percentiles (nearest rank).
+ */
+class Benchmark
+{
+private:
+    ISingleAgentPathFinder& Solver;
+    const Map& CurrentMap;
+    Weight CostWeight; // weight the solver minimizes
+    AStar Reference; // optimal under CostWeight, run once per query outside of the timed repetitions
+    std::size_t NumberOfWarmups, NumberOfRepetitions;
+    std::vector<QueryRecord> Queries;
+
+    QueryRecord Measure(const Agent&);
+    double GetCost(const Path&) const;
+    // status of a solved query
+    Validation Validate(const QueryRecord&) const;
+    static Percentiles Summarize(std::vector<double>&);
+    static BucketSummary Summarize(std::string, const std::vector<const QueryRecord*>&);
+
+public:
+    Benchmark(ISingleAgentPathFinder&, const Map&, const Weight, const std::size_t = 1, const std::size_t = 5);
+    Benchmark(const Benchmark&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+    virtual ~Benchmark() = default;
+
+    // agents are grouped by bucket, as given by Planner::GetAgents()
+    void Run(const std::vector<std::vector<Agent>>&);
+    const std::vector<QueryRecord>& GetQueries(void) const;
+    // a summary per bucket that has queries, followed by the summary of every query
+    std::vector<BucketSummary> GetBucketSummaries(void) const;
+    void WriteQueriesCsv(std::ostream&) const;
+    void WriteQueriesJson(std::ostream&) const;
+    void WriteSummariesCsv(std::ostream&) const;
+    void WriteSummariesJson(std::ostream&) const;
+};
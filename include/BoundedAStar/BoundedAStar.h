@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../Common/ISingleAgentPathFinder.h"
+#include "BoundedAStarNode.h"
+#include "../Common/SearchState.h"
+
+class Agent;
+class Map;
+
+typedef enum SuboptimalSearch
+{
+    // open-set ordered by g + w * h
+    WeightedAStarSearch,
+    // the focal list holds the open nodes whose f-value is within w times the least one, and is ordered by the
+    // estimated number of moves to the goal
+    FocalSearch,
+    // Explicit Estimation Search (Thayer and Ruml, 2011). h and the number of moves to the goal are corrected by
+    // the error observed between each expanded node and its best successor, the focal list holds the nodes whose
+    // corrected f-value is within w times the least one, and a node is expanded only if its corrected f-value is
+    // within w times the least f-value
+    ExplicitEstimationSearch
+}SuboptimalSearch;
+
+/*
+ * Bounded-suboptimal A*, which returns a path costing at most w times the cheapest one under an admissible
+ * heuristic, consistent for weighted A*. Every mode keeps a cleanup list of the open nodes ordered by f. A closed
+ * node reached by a cheaper path is not reopened but moved to an inconsistent list, as ARA* does, and the least
+ * f-value over both lists bounds the cheapest cost from below. Focal search and EES select only nodes within w
+ * times that bound, and reopen an inconsistent node once it holds the bound below 1/w of the open nodes.
+ * The report records the cost of the path over that bound when the goal is expanded, which is often well below w.
+ * A node belongs to several open lists at once and is erased from all of them once selected, hence the lists are
+ * quaternary heaps, each tracking the position of a node in a member of its own.
+ */
+class BoundedAStar : public ISingleAgentPathFinder
+{
+public:
+    using Store = SearchState<BoundedAStarNode>;
+    using cleanup_heap_t = DaryHeap<BoundedAStarNode, CleanupComparator, 4>;
+    using estimate_heap_t = DaryHeap<BoundedAStarNode, EstimateComparator, 4, EstimateIndexOf>;
+    using waiting_heap_t = DaryHeap<BoundedAStarNode, EstimateComparator, 4, SelectionIndexOf>;
+    using focal_heap_t = DaryHeap<BoundedAStarNode, DistanceComparator, 4, SelectionIndexOf>;
+
+private:
+    // open nodes of a search. weighted A* selects from Waiting alone, which then holds every open node
+    struct OpenSet
+    {
+        cleanup_heap_t Cleanup{};
+        estimate_heap_t Estimates{}; // EES only
+        waiting_heap_t Waiting{}; // open nodes outside of the focal list, ordered by estimate
+        focal_heap_t Focal{};
+        cleanup_heap_t Inconsistent{}; // closed nodes reached by a cheaper path since their expansion
+    };
+
+    Store Lookup;
+    SuboptimalSearch Mode;
+    double Suboptimality; // w
+    double AchievedBound; // cost of the path found over the least f-value of the open-set, 0 if none
+    // EES only, sums of the errors of h and of the number of moves observed over the expansions of a search
+    double SumOfHeuristicErrors, SumOfDistanceErrors;
+    unsigned int NumberOfErrorSamples;
+
+    int GetNumberOfMoves(const Coordinate&, const Coordinate&) const;
+    void Evaluate(BoundedAStarNode&, const double, const int) const;
+    void Insert(BoundedAStarNode*, OpenSet&);
+    void Improve(BoundedAStarNode*, OpenSet&);
+    void Remove(BoundedAStarNode*, OpenSet&);
+    void Reopen(OpenSet&);
+    double GetLowerBound(OpenSet&) const;
+    void RefreshFocal(OpenSet&);
+    BoundedAStarNode* Select(OpenSet&);
+    template<typename Model> void Expand(BoundedAStarNode*, const Coordinate&, OpenSet&, const Model&);
+    template<typename Model> bool Search(const Coordinate, const Coordinate&, const Model&);
+    bool Search(const Coordinate, const Coordinate&);
+    Path ReconstructPath(const Agent&);
+
+public:
+    BoundedAStar(const Heuristic = Euclidean, const Weight = UnitWeight);
+    BoundedAStar(const Map*, const Heuristic = Euclidean, const Weight = UnitWeight);
+    BoundedAStar(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
+    virtual ~BoundedAStar() = default;
+    void SetMode(const SuboptimalSearch);
+    // factors below 1 are raised to 1, which finds the cheapest path
+    void SetSuboptimality(const double = 1.05);
+    Path Solve(const Agent&) override;
+    Report SolveFullReport(const Agent&) override;
+};
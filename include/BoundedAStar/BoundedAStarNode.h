@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include "../Common/Coordinate.h"
+#include "../Common/OpenList.h"
+
+// fields of a node read by the open-sets. the cell, parent and status of a node are kept by SearchState
+class BoundedAStarNode
+{
+public:
+    double StaticValue; // f-value, g + h, orders the cleanup list which bounds the cheapest cost from below
+    double SumOfWeights; // g-value, the cheapest sum of weights found to reach this node
+    double Estimate; // g + w * h for weighted A*, f-value for focal search, f-hat (corrected f) for EES
+    double Distance; // estimated number of moves to the goal, corrected by the observed error for EES
+    std::uint32_t HeapIndex; // position in the cleanup list, or in the inconsistent list once closed, ordered by f
+    std::uint32_t SelectionIndex; // position in the focal list, or in the list of nodes waiting to join it
+    std::uint32_t EstimateIndex; // position in the list ordered by Estimate, EES only
+    bool IsFocal; // whether SelectionIndex refers to the focal list
+    bool IsInconsistent; // closed, then reached by a cheaper path
+
+    BoundedAStarNode();
+
+    friend std::ostream& operator<<(std::ostream&, const BoundedAStarNode&);
+};
+
+// f-value, ties prefer the larger g-value
+struct CleanupComparator
+{
+    bool operator() (const BoundedAStarNode*, const BoundedAStarNode*) const;
+};
+
+// estimate, ties prefer the larger g-value
+struct EstimateComparator
+{
+    bool operator() (const BoundedAStarNode*, const BoundedAStarNode*) const;
+};
+
+// distance to the goal, ties prefer the smaller estimate
+struct DistanceComparator
+{
+    bool operator() (const BoundedAStarNode*, const BoundedAStarNode*) const;
+};
+
+struct SelectionIndexOf
+{
+    static auto& Get(BoundedAStarNode* node) { return node->SelectionIndex; }
+};
+
+struct EstimateIndexOf
+{
+    static auto& Get(BoundedAStarNode* node) { return node->EstimateIndex; }
+};
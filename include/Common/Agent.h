@@ -5,10 +5,11 @@ class Agent
 {
 private:
     Coordinate Start, Goal;
+    double OptimalLength; // cost of an optimal path as given by the scenario, 0 if unknown
 
 public:
     Agent();
-    Agent(int const, int const, int const, int const);
+    Agent(int const, int const, int const, int const, double const = 0);
     Agent(Coordinate&&, Coordinate&&);
     Agent(Coordinate const&, Coordinate const&);
     Agent(Agent const&);
@@ -19,4 +20,5 @@ public:
 
     Coordinate GetStartCoordinate(void) const;
     Coordinate GetGoalCoordinate(void) const;
+    double GetOptimalLength(void) const;
 };
\ No newline at end of file
@@ -1,5 +1,10 @@
 #pragma once
 #include <iostream>
+#include <cstdint>
+
+// row-major index of a grid cell, row * columns + column. search nodes and their parents are identified by it,
+// coordinates are built from it only where a path is handed out.
+using CellId = std::uint32_t;
 
 class Coordinate
 {
@@ -10,14 +15,15 @@ private:
 public:
     Coordinate();
     Coordinate(int const, int const);
-    Coordinate(Coordinate const&);
-    Coordinate(Coordinate &&) noexcept ;
-    virtual ~Coordinate() = default;
+    // trivially copyable, hence without a vtable, so that a coordinate is as large as its two fields
+    Coordinate(Coordinate const&) = default;
+    Coordinate(Coordinate &&) noexcept = default;
+    ~Coordinate() = default;
     
     bool operator == (Coordinate const&) const;
     bool operator != (Coordinate const&) const;
-    Coordinate& operator = (Coordinate const&);
-    Coordinate& operator = (Coordinate&&) noexcept ;
+    Coordinate& operator = (Coordinate const&) = default;
+    Coordinate& operator = (Coordinate&&) noexcept = default;
     friend std::ostream& operator<<(std::ostream& out,const Coordinate& coordinate);
     
     int GetRow(void) const;
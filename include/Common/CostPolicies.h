@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cmath> // sqrt(), abs()
+#include <functional>
+#include <algorithm> // min(), max()
+#include "Coordinate.h"
+
+// Heuristic and weight policies. Solvers instantiate their search loops over a CostModel of two policies,
+// so that the estimation and the weight of every generated node are inlined into the expansion loop.
+// FunctionPolicy wraps a std::function and serves as the type-erased fallback for user supplied functions.
+
+constexpr double SQRT2 = 1.41421356237309504880;
+
+typedef enum Weight
+{
+    UnitWeight,
+    OctileWeight, // diagonal moves cost sqrt(2)
+    NWeight
+}Weight;
+
+struct EuclideanPolicy
+{
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        const double dr = src.GetRow() - dst.GetRow(), dc = src.GetColumn() - dst.GetColumn();
+        return std::sqrt(dr * dr + dc * dc);
+    }
+};
+
+struct ManhattanPolicy
+{
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        return std::abs(src.GetRow() - dst.GetRow()) + std::abs(src.GetColumn() - dst.GetColumn());
+    }
+};
+
+// exact distance over an empty 8-connected grid, when every move costs 1
+struct ChebyshevPolicy
+{
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        return std::max(std::abs(src.GetRow() - dst.GetRow()), std::abs(src.GetColumn() - dst.GetColumn()));
+    }
+};
+
+// exact distance over an empty 8-connected grid, when diagonal moves cost sqrt(2)
+struct OctilePolicy
+{
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        const int dr = std::abs(src.GetRow() - dst.GetRow()), dc = std::abs(src.GetColumn() - dst.GetColumn());
+        return std::max(dr, dc) + (SQRT2 - 1) * std::min(dr, dc);
+    }
+};
+
+// every move costs 1, staying in place costs 0
+struct UnitWeightPolicy
+{
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        return src != dst ? 1 : 0;
+    }
+};
+
+// straight moves cost 1, diagonal moves cost sqrt(2)
+struct OctileWeightPolicy
+{
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        const bool is_diagonal = src.GetRow() != dst.GetRow() && src.GetColumn() != dst.GetColumn();
+        return is_diagonal ? SQRT2 : (src != dst ? 1 : 0);
+    }
+};
+
+struct FunctionPolicy
+{
+    const std::function<double(const Coordinate&, const Coordinate&)>& Function;
+
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        return Function(src, dst);
+    }
+};
+
+template<typename HeuristicPolicy, typename WeightPolicy>
+struct CostModel
+{
+    HeuristicPolicy H;
+    WeightPolicy W;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <memory> // shared_ptr
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+#include "Coordinate.h"
+#include "ISingleAgentPathFinder.h" // HeuristicFunction, Weight
+
+class Map;
+
+// Exact cost-to-goal of every cell, computed by a backward Dijkstra sweep from the goal, for goals shared by many
+// queries. The tables of the most recently used goals are kept, up to a capacity given in megabytes.
+// Cells which cannot reach the goal are estimated as 0, which is harmless: A* never generates them from a start that
+// reaches the goal, and otherwise has to exhaust the start's component anyway.
+// The cache may be shared by several solvers, also across threads. Tables of a former version of the map are dropped.
+class GoalDistanceCache
+{
+public:
+    using Table = std::vector<float>; // cost of each cell, row-major
+
+private:
+    struct Entry
+    {
+        Coordinate Goal;
+        std::shared_ptr<const Table> Distances;
+    };
+
+    const Map* CurrentMap;
+    std::uint64_t MapVersion; // version of the map the cached tables were computed for
+    Weight MoveWeight;
+    std::size_t Capacity, Size; // in bytes
+    std::list<Entry> Entries; // most recently used first
+    std::unordered_map<Coordinate, std::list<Entry>::iterator, CoordinateHasher> Index;
+    mutable std::mutex Mutex;
+    unsigned long NumberOfHits, NumberOfMisses;
+
+    std::size_t CellIndex(const Coordinate&) const;
+    std::shared_ptr<const Table> Sweep(const Coordinate&) const;
+
+public:
+    GoalDistanceCache(const Map*, const Weight = UnitWeight, const std::size_t = 64);
+    GoalDistanceCache(const GoalDistanceCache&) = delete;
+    GoalDistanceCache& operator=(const GoalDistanceCache&) = delete;
+
+    // return the table of goal, computing it on a miss
+    std::shared_ptr<const Table> Find(const Coordinate&);
+    // heuristic of exact costs for a solver minimizing the given weight, which must be the cache's: unit costs
+    // underestimate octile ones, and octile costs overestimate unit ones, so a mismatch is reported and yields an
+    // empty function. paired with SetTieBreak(DeepTieBreak), a solver expands only the nodes of one optimal path.
+    // it keeps the table of the last goal it was asked about, so the cache is consulted only when the goal or the
+    // map changes. the cache must outlive it.
+    HeuristicFunction GetHeuristic(const Weight);
+    void Clear(void);
+    const Map* GetMap(void) const;
+    unsigned long GetNumberOfHits(void) const;
+    unsigned long GetNumberOfMisses(void) const;
+};
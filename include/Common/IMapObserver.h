@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Coordinate.h"
+
+class Map;
+
+// Notified by a Map whenever the passability of one of its cells is changed, right after the change took place.
+class IMapObserver
+{
+public:
+    virtual ~IMapObserver() = default;
+    virtual void OnPassabilityChanged(const Map&, const Coordinate&) = 0;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <vector>
+#include <memory> // shared_ptr
+#include <tuple>
+#include "Agent.h"
+#include "ISingleAgentPathFinder.h" // Path
+
+class Map;
+
+// path of every agent, in the order of the agents, holding its cell at every timestep. an agent stays at the last
+// cell of its path once the path ends. paths are immutable, so solutions which differ in a few agents share the rest.
+using Paths = std::vector<std::shared_ptr<const Path>>;
+// paths, agents, sum of costs, high-level expanded nodes, low-level searches, low-level expanded nodes
+using MultiAgentReport = std::tuple<Paths, std::vector<Agent>, unsigned long, unsigned int, unsigned int, unsigned long>;
+
+class IMultiAgentPathFinder
+{
+protected:
+    const Map* CurrentMap;
+    unsigned int NumberOfExpandedNodes; // nodes of the high-level search, if it has one
+    unsigned int NumberOfLowLevelSearches;
+    unsigned long NumberOfLowLevelExpandedNodes;
+    // every start and goal is a valid and passable cell, and no two agents share a start or a goal
+    bool ValidateAgents(const std::vector<Agent>&) const;
+    // number of timesteps until every agent has reached its goal for the last time, summed over the agents
+    static unsigned long GetSumOfCosts(const Paths&);
+
+public:
+    void SetMap(const Map*);
+    IMultiAgentPathFinder();
+    IMultiAgentPathFinder(const Map*);
+    IMultiAgentPathFinder(const IMultiAgentPathFinder&) = delete;
+    IMultiAgentPathFinder& operator=(const IMultiAgentPathFinder&) = delete;
+    virtual ~IMultiAgentPathFinder() = default;
+    virtual Paths Solve(const std::vector<Agent>&) = 0;
+    virtual MultiAgentReport SolveFullReport(const std::vector<Agent>&) = 0;
+};
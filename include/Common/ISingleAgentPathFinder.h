@@ -3,6 +3,9 @@
 #include <vector> // Path
 #include <functional>
 #include "Coordinate.h"
+#include "OpenList.h" // OpenListType, TieBreak
+#include "CostPolicies.h"
+#include "Landmarks.h" // DifferentialPolicy
 
 class Map;
 class Agent;
@@ -10,32 +13,108 @@ class Agent;
 using Path = std::vector<Coordinate>;
 using HeuristicFunction = std::function<double(const Coordinate&, const Coordinate&)>;
 using WeightFunction  = std::function<double(const Coordinate&, const Coordinate&)>;
-using Report = std::tuple<Path, Agent, unsigned int, unsigned int, unsigned int, unsigned long>;
+// path, agent, expanded, generated and popped nodes, max open-set size, peak memory of the search state in bytes,
+// nodes repaired after changes of the map (incremental solvers only), and the suboptimality bound achieved: the cost
+// of the path over the least f-value left in the open-set, a lower bound on the cheapest cost under an admissible
+// heuristic. 1 for optimal solvers, infinity if no bound is known, 0 if no path was found.
+using Report = std::tuple<Path, Agent, unsigned int, unsigned int, unsigned int, unsigned long, std::size_t, unsigned int,
+                          double>;
 
 typedef enum Heuristic
 {
     Euclidean,
     Manhattan,
+    Chebyshev,
+    Octile,
+    Differential, // landmark based, requires Planner::PrepareDifferentialHeuristic() for the weight in use
     NHeuristic
 }Heuristic;
 
+// structure of the values produced by the weight and heuristic functions, used to specialize the open-set
+typedef enum CostStructure
+{
+    IntegralCost, // weights and heuristic estimations are integers
+    OctileCost, // weights and heuristic estimations are of the form a + b * sqrt(2), where a, b are integers
+    ArbitraryCost
+}CostStructure;
+
 
 class ISingleAgentPathFinder
 {
 protected:
-    Map* CurrentMap;
+    const Map* CurrentMap;
     HeuristicFunction H;
     WeightFunction W;
+    Heuristic HeuristicType;
+    Weight WeightType;
+    bool IsCustomHeuristic, IsCustomWeight; // H or W were supplied by the user, their policy is FunctionPolicy
+    CostStructure Costs;
+    TieBreak TieOrder;
     unsigned int NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations;
     unsigned long MaxHeapSize;
+    std::size_t PeakMemory;
     bool IsGoal(const Coordinate&, const Coordinate&);
+    // whether a map is set and the start, and the goal if requested, lie within its grid, reported on behalf of the
+    // calling function otherwise
+    bool IsValidQuery(const char*, const Agent&, const bool = false) const;
+    OpenListType SelectOpenList(const OpenListType) const;
+    CostStructure DeduceCostStructure(void) const;
+    const LandmarkTable& GetLandmarks(const Weight) const;
+
+    // invoke search with a CostModel of the configured heuristic and weight, so that both are inlined into it
+    template<typename Search>
+    auto WithCostModel(Search&& search) const
+    {
+        if(IsCustomHeuristic)
+        {
+            return WithWeightPolicy(search, FunctionPolicy{H});
+        }
+        switch(HeuristicType)
+        {
+            case Manhattan:
+                return WithWeightPolicy(search, ManhattanPolicy());
+            case Chebyshev:
+                return WithWeightPolicy(search, ChebyshevPolicy());
+            case Octile:
+                return WithWeightPolicy(search, OctilePolicy());
+            case Differential:
+                // a custom weight function is assumed to cost at least 1 per move, as the unit weight table does
+                if(!IsCustomWeight && WeightType == OctileWeight)
+                {
+                    return WithWeightPolicy(search, DifferentialPolicy<OctilePolicy>{GetLandmarks(OctileWeight)});
+                }
+                return WithWeightPolicy(search, DifferentialPolicy<ChebyshevPolicy>{GetLandmarks(UnitWeight)});
+            default:
+                return WithWeightPolicy(search, EuclideanPolicy());
+        }
+    }
+
+    template<typename Search, typename HeuristicPolicy>
+    auto WithWeightPolicy(Search& search, const HeuristicPolicy& heuristic) const
+    {
+        if(IsCustomWeight)
+        {
+            return search(CostModel<HeuristicPolicy, FunctionPolicy>{heuristic, FunctionPolicy{W}});
+        }
+        switch(WeightType)
+        {
+            case OctileWeight:
+                return search(CostModel<HeuristicPolicy, OctileWeightPolicy>{heuristic, OctileWeightPolicy()});
+            default:
+                return search(CostModel<HeuristicPolicy, UnitWeightPolicy>{heuristic, UnitWeightPolicy()});
+        }
+    }
 
 public:
-    void SetMap(Map*);
+    void SetMap(const Map*);
     void SetHeuristic(const Heuristic = Euclidean);
-    ISingleAgentPathFinder(const Heuristic = Euclidean);
-    ISingleAgentPathFinder(Map*, const Heuristic = Euclidean);
-    ISingleAgentPathFinder(Map*, const HeuristicFunction&, const WeightFunction&);
+    void SetWeight(const Weight = UnitWeight);
+    // honored by AStar, PEAStar and RBFS. bucket queues break ties toward the smaller g-value only, hence they are
+    // replaced by the quaternary heap under DeepTieBreak
+    void SetTieBreak(const TieBreak = ShallowTieBreak);
+    ISingleAgentPathFinder(const Heuristic = Euclidean, const Weight = UnitWeight);
+    ISingleAgentPathFinder(const Map*, const Heuristic = Euclidean, const Weight = UnitWeight);
+    ISingleAgentPathFinder(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
     virtual ~ISingleAgentPathFinder() = default;
     virtual Path Solve(const Agent&) = 0;
     virtual Report SolveFullReport(const Agent&) = 0;
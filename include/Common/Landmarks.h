@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <cstdlib> // abs()
+#include <algorithm> // max()
+#include "Coordinate.h"
+#include "CostPolicies.h" // Weight, ChebyshevPolicy, OctilePolicy
+
+class Map;
+
+// Exact distances from a few landmark cells to every cell of a map, used by the differential heuristic:
+// by the triangle inequality |d(L, n) - d(L, goal)| <= d(n, goal) for every landmark L.
+// Distances are computed for a weight, in fixed point of 1 / Scale moves. Under octile weight the diagonal move
+// is rounded down to 45 / 32, so stored distances never exceed the true ones and the estimation stays admissible.
+// Landmarks are chosen by farthest-point selection, so that they spread over the map and its components.
+class LandmarkTable
+{
+public:
+    // distance of a cell which is unreachable from the landmark, or too far to be stored
+    static constexpr std::uint16_t UNKNOWN_DISTANCE = 0xFFFF;
+
+private:
+    int NumberOfRows, NumberOfColumns;
+    std::size_t NumberOfLandmarks;
+    Weight MoveWeight;
+    std::uint16_t Scale; // stored distance of a straight move
+    double InverseScale;
+    std::vector<Coordinate> Landmarks;
+    // distance of cell c from landmark l is at c * NumberOfLandmarks + l, so an estimation reads two short runs
+    std::vector<std::uint16_t> Distances;
+    std::uint64_t MapDigest; // identifies the passability of the map the table was built for
+
+    std::size_t CellIndex(const Coordinate&) const;
+    void SetWeight(const Weight);
+    std::uint16_t DiagonalMoveDistance(void) const;
+    void Sweep(const Map&, const Coordinate&, std::vector<std::uint16_t>&) const;
+    static std::uint64_t Digest(const Map&);
+
+public:
+    LandmarkTable();
+
+    bool IsEmpty(void) const;
+    std::size_t GetNumberOfLandmarks(void) const;
+    Weight GetWeight(void) const;
+    const std::vector<Coordinate>& GetLandmarks(void) const;
+    void Build(const Map&, const std::size_t, const Weight);
+    // save to and load from a binary file, Load fails if the file was built for a different map
+    bool Save(const char*) const;
+    bool Load(const char*, const Map&);
+    // the same binary layout within a stream, e.g. a section of a compiled map, and within a block of memory
+    bool Save(std::ostream&) const;
+    bool Load(std::string_view, const Map&);
+
+    // lower bound on the cost from src to dst, 0 when no landmark is informative
+    double Estimate(const Coordinate& src, const Coordinate& dst) const
+    {
+        if(Distances.empty())
+        {
+            return 0;
+        }
+        const std::uint16_t* src_distances = &Distances[CellIndex(src) * NumberOfLandmarks];
+        const std::uint16_t* dst_distances = &Distances[CellIndex(dst) * NumberOfLandmarks];
+        int estimation = 0;
+        for(std::size_t landmark = 0; landmark < NumberOfLandmarks; landmark++)
+        {
+            const int src_distance = src_distances[landmark], dst_distance = dst_distances[landmark];
+            if(src_distance != UNKNOWN_DISTANCE && dst_distance != UNKNOWN_DISTANCE)
+            {
+                estimation = std::max(estimation, std::abs(src_distance - dst_distance));
+            }
+        }
+        return estimation * InverseScale;
+    }
+};
+
+inline std::size_t LandmarkTable::CellIndex(const Coordinate& coordinate) const
+{
+    return static_cast<std::size_t>(coordinate.GetRow()) * NumberOfColumns + coordinate.GetColumn();
+}
+
+// landmark lower bound, never weaker than the free-space distance of BasePolicy for the same weight
+template<typename BasePolicy>
+struct DifferentialPolicy
+{
+    const LandmarkTable& Landmarks;
+
+    double operator()(const Coordinate& src, const Coordinate& dst) const
+    {
+        return std::max(Landmarks.Estimate(src, dst), BasePolicy()(src, dst));
+    }
+};
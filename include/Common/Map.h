@@ -1,26 +1,99 @@
 #pragma once
 
 #include <vector> // grid_t
+#include <array>
+#include <cstdint>
+#include <string_view>
 #include "Coordinate.h"
+#include "Landmarks.h"
+#include "IMapObserver.h"
+#include "MappedFile.h"
 class Agent;
 
 class Map
 {
 private:
-    using grid_t = std::vector<std::vector<unsigned char>>;
-    grid_t Grid;
+    using grid_t = std::vector<unsigned char>;
     int NumberOfRows, NumberOfColumns;
+    // a grid parsed from text is held by the storage vectors, while a compiled grid is used in place from its
+    // mapping. Grid, PassableBits, NeighborMasks and ComponentIds view either one.
+    grid_t GridStorage;
+    std::vector<std::uint64_t> PassableStorage;
+    std::vector<std::uint8_t> MaskStorage;
+    std::vector<std::uint32_t> ComponentStorage;
+    MappedFile Compiled;
+    unsigned char* Grid; // terrain of each cell, row-major
+    // passability bitmap, padded with a frame of impassable cells so that neighbors of any cell can be tested
+    // without bounds checks. bit of coordinate (r, c) is at (r + 1) * (NumberOfColumns + 2) + (c + 1).
+    std::uint64_t* PassableBits;
+    // bit i of cell mask is set iff moving from the cell along eight_principle_directions[i] is legal
+    std::uint8_t* NeighborMasks;
+    // connected component of each cell under the moves of the neighbor masks, 0 for impassable cells. a cell blocked
+    // by SetPassable() may split its component, whose cells keep their label, hence cells of different labels are
+    // never connected while cells of a label may no longer be.
+    std::uint32_t* ComponentIds;
+    std::uint32_t NumberOfComponents; // labels handed out so far, merged components leave some of them unused
+    std::array<std::int32_t, 8> NeighborOffsets; // cell id offset of each of eight_principle_directions
+    std::uint64_t SourceChecksum; // of the .map file the grid was read from, 0 once the grid was changed
+    std::array<LandmarkTable, NWeight> Landmarks; // per weight, empty unless the differential heuristic was prepared
+    std::uint64_t Version; // incremented whenever the grid changes, so derived tables can tell they are outdated
+    // observers do not take part in the state of the map, hence solvers holding a const map may register
+    mutable std::vector<IMapObserver*> Observers;
+
+    static bool IsPassableTerrain(unsigned char const);
+    static std::uint64_t Checksum(std::string_view);
+    std::size_t CellIndex(int const, int const) const;
+    std::size_t PaddedIndex(int const, int const) const;
+    bool IsPassableCell(int const, int const) const;
+    void SetDimensions(int const, int const);
+    void BuildNeighborMasks(void);
+    void UpdateNeighborMasks(int const, int const);
+    void BuildComponents(void);
+    void LabelComponent(std::size_t const, std::uint32_t const);
+    void UpdateComponents(int const, int const);
 
 public:
     Map();
     Map(char* const);
+    Map(const Map&) = delete;
+    Map& operator=(const Map&) = delete;
     virtual ~Map() = default;
 
-    bool IsValidCoordinate(Coordinate const&);
-    bool IsPassableCoordinate(Coordinate const&);
+    bool IsValidCoordinate(Coordinate const&) const;
+    bool IsPassableCoordinate(Coordinate const&) const;
+    // parse a MovingAI .map file. a malformed file is reported with its line, and leaves the former grid unchanged.
     bool Load(char const*);
-    void SetAgent(Agent const&);
-    void RemoveAgent(Agent const&);
-    std::string GetGridWithSolution(std::vector<Coordinate>&, const Agent&);
+    /*
+     * Save the grid with its derived tables as a compiled map (.mapc), and map one back. The compiled map is used
+     * in place, so loading it costs a single mmap and a pass over the cells, which verifies the derived tables
+     * against the terrain. Loading fails if the compiled map is malformed or inconsistent, or when a .map file is
+     * given which differs from the one it was compiled from.
+     */
+    bool SaveCompiled(char const*) const;
+    bool LoadCompiled(char const*, char const* = nullptr);
+    int GetNumberOfRows(void) const;
+    int GetNumberOfColumns(void) const;
+    CellId GetCellId(Coordinate const&) const;
+    Coordinate GetCoordinate(CellId const) const;
+    // bit i is set when the neighbor along eight_principle_directions[i] lies within the grid and is passable, so
+    // solvers expanding a cell along its set bits need no further validity or passability checks
+    std::uint8_t GetNeighborMask(Coordinate const&) const;
+    std::uint8_t GetNeighborMask(CellId const) const;
+    // the cell id of the neighbor along eight_principle_directions[i] is the cell id plus the i-th offset
+    const std::array<std::int32_t, 8>& GetNeighborOffsets(void) const;
+    std::uint32_t GetComponent(Coordinate const&) const;
+    // false unless both coordinates are valid and passable, and possibly connected. an O(1) test, so that solvers
+    // reject unreachable goals without exhausting the component of the start.
+    bool AreConnected(Coordinate const&, Coordinate const&) const;
+    std::uint64_t GetVersion(void) const;
+    // block or unblock a cell and notify the observers, fails for a coordinate outside of the grid.
+    // the map must not be searched meanwhile. landmarks of the former grid are discarded.
+    bool SetPassable(Coordinate const&, bool const);
+    void AddObserver(IMapObserver*) const;
+    void RemoveObserver(IMapObserver*) const;
+    const LandmarkTable& GetLandmarks(const Weight) const;
+    void SetLandmarks(LandmarkTable&&);
+    // render the grid with the solution highlighted, the start and goal of agent are marked as 'A' and 'G'
+    std::string GetGridWithSolution(const std::vector<Coordinate>&, const Agent&) const;
     std::string GetGrid(void) const;
 };
\ No newline at end of file
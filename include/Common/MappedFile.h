@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Memory mapping of a whole file, unmapped when the object is destroyed or another file is opened.
+class MappedFile
+{
+private:
+    char* Data;
+    std::size_t Size;
+    bool IsWritable;
+
+public:
+    MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) noexcept;
+    MappedFile& operator=(MappedFile&&) noexcept;
+    ~MappedFile();
+
+    // fails for a missing, unreadable or non-regular file. an empty file is opened with no data.
+    // a writable mapping is private, pages are copied on their first write and the file itself never changes.
+    bool Open(const char*, const bool = false);
+    void Close(void);
+    std::string_view GetView(void) const;
+    // nullptr unless opened as writable
+    char* GetWritableData(void) const;
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm> // fill()
+#include "Coordinate.h"
+
+// Grid-indexed storage of search nodes: a single contiguous slot per map cell, addressed by row * columns + column.
+// A slot is considered generated only if its generation stamp matches the store's current generation,
+// hence starting a new search costs a counter increment instead of clearing (or re-allocating) the whole table.
+// Node addresses remain stable for the lifetime of a search, so open-sets may hold raw pointers into the store.
+// Nodes may be addressed either by coordinate or by cell id, the latter being the slot index itself.
+template<typename Node>
+class NodeStore
+{
+private:
+    std::vector<Node> Nodes;
+    std::vector<std::uint32_t> Generations; // generation in which each slot was last initialized
+    std::uint32_t CurrentGeneration;
+    int NumberOfRows, NumberOfColumns;
+
+    std::size_t Index(const Coordinate& coordinate) const
+    {
+        return static_cast<std::size_t>(coordinate.GetRow()) * NumberOfColumns + coordinate.GetColumn();
+    }
+
+public:
+    NodeStore(): Nodes(), Generations(), CurrentGeneration(0), NumberOfRows(0), NumberOfColumns(0) {}
+
+    // invalidate all nodes of the previous search. re-allocates only when the grid shape has changed.
+    void Reset(int const rows, int const columns)
+    {
+        if(rows != NumberOfRows || columns != NumberOfColumns)
+        {
+            NumberOfRows = rows;
+            NumberOfColumns = columns;
+            const std::size_t number_of_cells = static_cast<std::size_t>(rows) * columns;
+            Nodes.assign(number_of_cells, Node());
+            Generations.assign(number_of_cells, 0);
+            CurrentGeneration = 0;
+        }
+        if(++CurrentGeneration == 0)
+        {
+            // generation counter wrapped around, stale stamps may collide with the new generation
+            std::fill(Generations.begin(), Generations.end(), 0);
+            CurrentGeneration = 1;
+        }
+    }
+
+    bool Contains(const Coordinate& coordinate) const
+    {
+        return Contains(static_cast<CellId>(Index(coordinate)));
+    }
+
+    bool Contains(const CellId cell) const
+    {
+        return Generations[cell] == CurrentGeneration;
+    }
+
+    // bytes held by the store, which covers every cell of the grid whether or not it is reached
+    std::size_t GetMemoryUsage(void) const
+    {
+        return Nodes.capacity() * sizeof(Node) + Generations.capacity() * sizeof(std::uint32_t);
+    }
+
+    // return pointer to the node of coordinate if it was created during the current search, nullptr otherwise
+    Node* Find(const Coordinate& coordinate)
+    {
+        return Find(static_cast<CellId>(Index(coordinate)));
+    }
+
+    Node* Find(const CellId cell)
+    {
+        return Generations[cell] == CurrentGeneration ? &Nodes[cell] : nullptr;
+    }
+
+    // return the node of coordinate, default-initialize it on first access during the current search
+    Node& operator[](const Coordinate& coordinate)
+    {
+        return (*this)[static_cast<CellId>(Index(coordinate))];
+    }
+
+    Node& operator[](const CellId cell)
+    {
+        if(Generations[cell] != CurrentGeneration)
+        {
+            Nodes[cell] = Node();
+            Generations[cell] = CurrentGeneration;
+        }
+        return Nodes[cell];
+    }
+};
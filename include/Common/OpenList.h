@@ -0,0 +1,468 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <cmath> // floor(), abs()
+#include <algorithm> // min(), max(), sort(), upper_bound(), push_heap(), pop_heap()
+#include <boost/heap/fibonacci_heap.hpp>
+
+// Open-set implementations shared by the solvers. All of them expose the same minimal interface
+// (push, top, pop, decrease, empty, size, clear) over pointers to nodes that live in a NodeStore or a SearchState.
+// Comparator follows the boost convention: Compare(a, b) is true when a has lower priority than b.
+// Every node type must provide an unsigned HeapIndex member, which the open-set owns while the node is queued.
+// Grid nodes keep it 32-bit, as no open-set holds more entries than the grid has cells.
+
+typedef enum OpenListType
+{
+    QuaternaryHeapOpenList,
+    FibonacciHeapOpenList,
+    BucketOpenList, // two-level bucket queue over unit intervals of f-values, e.g. octile costs
+    IntegralBucketOpenList, // two-level bucket queue, requires integral f and g values
+    AutomaticOpenList, // pick a bucket queue when the cost structure permits it, quaternary heap otherwise
+    NOpenListType
+}OpenListType;
+
+// order among open nodes of equal f-value
+typedef enum TieBreak
+{
+    ShallowTieBreak, // smaller g-value first
+    // larger g-value first. under an exact heuristic every node of an optimal path shares the f-value of the goal,
+    // and this order expands a single such path instead of spreading over all of them
+    DeepTieBreak
+}TieBreak;
+
+// whether two f-values tie under DeepTieBreak. sums of irrational weights, and estimations read from float tables,
+// round the f-values of equally long paths apart, hence values within a relative tolerance tie. the path found
+// may cost that much more than the cheapest one.
+inline bool IsTie(const double f1, const double f2)
+{
+    constexpr double TIE_TOLERANCE = 1e-6;
+    return std::abs(f1 - f2) <= TIE_TOLERANCE * std::max(std::abs(f1), std::abs(f2));
+}
+
+// Member of a node which holds its position within a DaryHeap. A node queued in several heaps at once gives each
+// of them a policy of its own.
+template<typename Node>
+struct HeapIndexOf
+{
+    static auto& Get(Node* node) { return node->HeapIndex; }
+};
+
+// Array-backed d-ary min-heap. The position of each node within the array is kept in Node::HeapIndex, or in the
+// member selected by Position, hence decrease-key is an in-place sift-up and no per-push allocation takes place.
+template<typename Node, typename Comparator, std::size_t Arity = 4, typename Position = HeapIndexOf<Node>>
+class DaryHeap
+{
+private:
+    std::vector<Node*> Heap;
+    Comparator Compare;
+
+    void Place(Node* node, const std::size_t position)
+    {
+        Heap[position] = node;
+        Position::Get(node) = position;
+    }
+
+    void SiftUp(std::size_t position)
+    {
+        Node* node = Heap[position];
+        while(position > 0)
+        {
+            const std::size_t parent = (position - 1) / Arity;
+            if(!Compare(Heap[parent], node))
+            {
+                break;
+            }
+            Place(Heap[parent], position);
+            position = parent;
+        }
+        Place(node, position);
+    }
+
+    void SiftDown(std::size_t position)
+    {
+        Node* node = Heap[position];
+        const std::size_t size = Heap.size();
+        while(true)
+        {
+            const std::size_t first_child = position * Arity + 1;
+            if(first_child >= size)
+            {
+                break;
+            }
+            const std::size_t last_child = std::min(first_child + Arity, size);
+            std::size_t best_child = first_child;
+            for(std::size_t child = first_child + 1; child < last_child; child++)
+            {
+                if(Compare(Heap[best_child], Heap[child]))
+                {
+                    best_child = child;
+                }
+            }
+            if(!Compare(node, Heap[best_child]))
+            {
+                break;
+            }
+            Place(Heap[best_child], position);
+            position = best_child;
+        }
+        Place(node, position);
+    }
+
+public:
+    DaryHeap(): Heap(), Compare() {}
+
+    bool empty(void) const { return Heap.empty(); }
+    std::size_t size(void) const { return Heap.size(); }
+    Node* top(void) const { return Heap.front(); }
+    void clear(void) { Heap.clear(); }
+
+    void push(Node* node)
+    {
+        Heap.push_back(node);
+        SiftUp(Heap.size() - 1);
+    }
+
+    void pop(void)
+    {
+        Node* last = Heap.back();
+        Heap.pop_back();
+        if(!Heap.empty())
+        {
+            Heap.front() = last;
+            SiftDown(0);
+        }
+    }
+
+    // restore heap order after the priority of an already queued node has been improved
+    void decrease(Node* node)
+    {
+        SiftUp(Position::Get(node));
+    }
+
+    // restore heap order after the priority of an already queued node has changed in either direction
+    void update(Node* node)
+    {
+        SiftUp(Position::Get(node));
+        SiftDown(Position::Get(node));
+    }
+
+    // hand out the queued nodes in no particular order and leave the heap empty, e.g. to queue them again under
+    // new priorities
+    std::vector<Node*> release(void)
+    {
+        std::vector<Node*> nodes;
+        nodes.swap(Heap);
+        return nodes;
+    }
+
+    // remove a queued node from any position
+    void erase(Node* node)
+    {
+        const std::size_t position = Position::Get(node);
+        Node* last = Heap.back();
+        Heap.pop_back();
+        if(position < Heap.size())
+        {
+            Place(last, position);
+            update(last);
+        }
+    }
+};
+
+// Adapter over boost fibonacci heap, kept selectable for comparison with DaryHeap.
+// Node::HeapIndex refers to the boost handle of the node within Handles.
+template<typename Node, typename Comparator>
+class FibonacciHeap
+{
+private:
+    using heap_t = boost::heap::fibonacci_heap<Node*, boost::heap::compare<Comparator>>;
+    heap_t Heap;
+    std::vector<typename heap_t::handle_type> Handles;
+
+public:
+    FibonacciHeap(): Heap(), Handles() {}
+
+    bool empty(void) const { return Heap.empty(); }
+    std::size_t size(void) const { return Heap.size(); }
+    Node* top(void) const { return Heap.top(); }
+    void pop(void) { Heap.pop(); }
+
+    void clear(void)
+    {
+        Heap.clear();
+        Handles.clear();
+    }
+
+    void push(Node* node)
+    {
+        node->HeapIndex = Handles.size();
+        Handles.push_back(Heap.push(node));
+    }
+
+    // a decreased f-value is a raise in priority, which boost refers to as increase
+    void decrease(Node* node)
+    {
+        Heap.increase(Handles[node->HeapIndex]);
+    }
+};
+
+// Two-level bucket open-set for non-negative f-values. The first level is indexed by the integral part of f,
+// and the best bucket is tracked by a cursor, so locating the minimum does not depend on the number of queued nodes.
+// Ties on f are broken in favor of the smaller g, then in insertion order, as done by the solvers' comparators.
+// With IntegralKeys all entries of a bucket share the same f-value. When the cursor reaches a bucket, its entries are
+// distributed into FIFO slots indexed by g (second level), and further pushes to it append to their slot,
+// hence push and pop are amortized O(1).
+// Otherwise (e.g. octile costs, f = a + b * sqrt(2)) a bucket holds a small binary heap ordered by f, then by g.
+// Decrease-key is lazy: the node is queued again with a fresh ticket (kept in Node::HeapIndex) and the outdated
+// entry is discarded once it reaches the front. Node must provide StaticValue (f) and SumOfWeights (g) members, a node
+// type ordered by another value overloads GetQueueKey().
+template<typename Node>
+inline double GetQueueKey(const Node& node)
+{
+    return node.StaticValue;
+}
+
+template<typename Node, bool IntegralKeys>
+class BucketQueue
+{
+private:
+    using Ticket = decltype(Node::HeapIndex);
+
+    struct Entry
+    {
+        Node* node;
+        Ticket ticket;
+        double f, g; // keys at insertion time, the node itself may be updated afterwards
+    };
+
+    struct Slot
+    {
+        std::vector<Entry> Entries{};
+        std::size_t Head = 0; // entries before Head were already popped
+    };
+
+    std::deque<std::vector<Entry>> Buckets; // unordered (integral) or heap ordered entries
+    long Base; // key of Buckets.front()
+    long Cursor; // key of the bucket holding the best entry
+    std::size_t Size; // number of entries which are not outdated
+    Ticket Tickets;
+    // second level of the bucket under the cursor, used only with IntegralKeys
+    std::vector<Slot> Slots;
+    long ActiveKey; // key of the bucket distributed into Slots, or NONE
+    long SlotBase; // g-value of Slots.front()
+    std::size_t SlotCursor; // index of the first slot which may hold entries
+    static constexpr long NONE = -1;
+
+    // whether e1 has lower priority than e2
+    static bool IsWorse(const Entry& e1, const Entry& e2)
+    {
+        if(e1.f != e2.f)
+        {
+            return e1.f > e2.f;
+        }
+        return (e1.g == e2.g) ? (e1.ticket > e2.ticket) : (e1.g > e2.g);
+    }
+
+    static long Key(const double value)
+    {
+        constexpr double EPSILON = 1e-9; // absorb rounding errors of sums of irrational weights
+        return static_cast<long>(std::floor(value + EPSILON));
+    }
+
+    static bool IsOutdated(const Entry& entry)
+    {
+        return entry.ticket != entry.node->HeapIndex;
+    }
+
+    std::vector<Entry>& BucketOf(const long key)
+    {
+        for(; key < Base; Base--)
+        {
+            Buckets.emplace_front();
+        }
+        while(key - Base >= static_cast<long>(Buckets.size()))
+        {
+            Buckets.emplace_back();
+        }
+        return Buckets[key - Base];
+    }
+
+    void InsertToSlot(const Entry& entry)
+    {
+        const long g = Key(entry.g);
+        if(g < SlotBase)
+        {
+            Slots.insert(Slots.begin(), SlotBase - g, Slot());
+            SlotBase = g;
+            SlotCursor = 0;
+        }
+        const std::size_t index = g - SlotBase;
+        if(index >= Slots.size())
+        {
+            Slots.resize(index + 1);
+        }
+        Slots[index].Entries.push_back(entry);
+        SlotCursor = std::min(SlotCursor, index);
+    }
+
+    // move the entries left in Slots back to their bucket
+    void Deactivate(void)
+    {
+        std::vector<Entry>& bucket = Buckets[ActiveKey - Base];
+        for(Slot& slot : Slots)
+        {
+            bucket.insert(bucket.end(), slot.Entries.begin() + slot.Head, slot.Entries.end());
+            slot.Entries.clear();
+            slot.Head = 0;
+        }
+        ActiveKey = NONE;
+    }
+
+    // distribute the bucket under the cursor into Slots, keeping insertion order within each slot
+    void Activate(void)
+    {
+        std::vector<Entry>& bucket = Buckets[Cursor - Base];
+        long min_g = Key(bucket.front().g), max_g = min_g;
+        for(const Entry& entry : bucket)
+        {
+            min_g = std::min(min_g, Key(entry.g));
+            max_g = std::max(max_g, Key(entry.g));
+        }
+        Slots.resize(max_g - min_g + 1);
+        SlotBase = min_g;
+        SlotCursor = 0;
+        for(const Entry& entry : bucket)
+        {
+            Slots[Key(entry.g) - SlotBase].Entries.push_back(entry);
+        }
+        bucket.clear();
+        ActiveKey = Cursor;
+    }
+
+    // advance the cursors to the best entry which is not outdated, return it or nullptr if none is left
+    const Entry* Settle(void)
+    {
+        while(Cursor - Base < static_cast<long>(Buckets.size()))
+        {
+            if(!IntegralKeys)
+            {
+                std::vector<Entry>& bucket = Buckets[Cursor - Base];
+                if(bucket.empty())
+                {
+                    Cursor++;
+                }
+                else if(IsOutdated(bucket.front()))
+                {
+                    std::pop_heap(bucket.begin(), bucket.end(), IsWorse);
+                    bucket.pop_back();
+                }
+                else
+                {
+                    return &bucket.front();
+                }
+                continue;
+            }
+            if(ActiveKey != Cursor)
+            {
+                if(ActiveKey != NONE)
+                {
+                    Deactivate();
+                }
+                if(Buckets[Cursor - Base].empty())
+                {
+                    Cursor++;
+                    continue;
+                }
+                Activate();
+            }
+            for(; SlotCursor < Slots.size(); SlotCursor++)
+            {
+                Slot& slot = Slots[SlotCursor];
+                while(slot.Head < slot.Entries.size() && IsOutdated(slot.Entries[slot.Head]))
+                {
+                    slot.Head++;
+                }
+                if(slot.Head < slot.Entries.size())
+                {
+                    return &slot.Entries[slot.Head];
+                }
+                slot.Entries.clear();
+                slot.Head = 0;
+            }
+            ActiveKey = NONE; // all slots are empty
+            Cursor++;
+        }
+        return nullptr;
+    }
+
+public:
+    BucketQueue(): Buckets(), Base(0), Cursor(0), Size(0), Tickets(0), Slots(), ActiveKey(NONE), SlotBase(0), SlotCursor(0) {}
+
+    bool empty(void) const { return Size == 0; }
+    std::size_t size(void) const { return Size; }
+
+    Node* top(void)
+    {
+        return Settle()->node;
+    }
+
+    void clear(void)
+    {
+        Buckets.clear();
+        Slots.clear();
+        ActiveKey = NONE;
+        Size = 0;
+    }
+
+    void push(Node* node)
+    {
+        const Entry entry = {node, ++Tickets, GetQueueKey(*node), node->SumOfWeights};
+        const long key = Key(entry.f);
+        node->HeapIndex = entry.ticket;
+        if(Buckets.empty())
+        {
+            Base = Cursor = key;
+        }
+        std::vector<Entry>& bucket = BucketOf(key);
+        if(!IntegralKeys)
+        {
+            bucket.push_back(entry);
+            std::push_heap(bucket.begin(), bucket.end(), IsWorse);
+        }
+        else if(key == ActiveKey)
+        {
+            InsertToSlot(entry);
+        }
+        else
+        {
+            bucket.push_back(entry);
+        }
+        Cursor = std::min(Cursor, key);
+        Size++;
+    }
+
+    void pop(void)
+    {
+        const Entry* best = Settle();
+        best->node->HeapIndex = 0; // outdate any remaining entry of this node
+        if(IntegralKeys)
+        {
+            Slots[SlotCursor].Head++;
+        }
+        else
+        {
+            std::vector<Entry>& bucket = Buckets[Cursor - Base];
+            std::pop_heap(bucket.begin(), bucket.end(), IsWorse);
+            bucket.pop_back();
+        }
+        Size--;
+    }
+
+    // re-queue a node whose f-value or g-value has been improved, its former entry becomes outdated
+    void decrease(Node* node)
+    {
+        Size--;
+        push(node);
+    }
+};
@@ -2,28 +2,47 @@
 
 #include "Map.h"
 #include <vector>
+#include <memory> // unique_ptr
+#include <thread> // hardware_concurrency()
+#include <functional>
+#include <limits>
 #include "Agent.h"
 #include "ISingleAgentPathFinder.h"
+#include "IMultiAgentPathFinder.h"
 
 class Planner
 {
+public:
+    // creates an independent solver for each worker of a parallel run
+    using SolverFactory = std::function<std::unique_ptr<ISingleAgentPathFinder>(void)>;
+
 private:
     Map CurrentMap;
+    std::string MapPath;
     std::vector<std::vector<Agent>> Agents; // group agents by bucket
     ISingleAgentPathFinder* SingleAgentPathFinder;
-    void LoadAgents(std::ifstream&, float const);
-    float ParseVersion(std::ifstream&);
-    bool ValidateVersion(float const);
+    void DisplayOutcome(Report&, int&, int&);
+    void DisplayOutcome(MultiAgentReport&);
+    // load a .mapc path as is, or a .map path through the compiled map next to it when that one is up to date
+    bool LoadMap(void);
 
 public:
     Planner(const char* const, const char* const);
     virtual ~Planner() = default;
 
     const std::vector<std::vector<Agent>>& GetAgents(void) const;
-    Map& GetMap(void);
-    void SetAgentOnMap(Agent const&);
-    void RemoveAgentFromMap(Agent const&);
+    const Map& GetMap(void) const;
     void SetSingleAgentPathFinder(ISingleAgentPathFinder*);
+    // compile the map with its prepared landmarks next to the source map, for later runs to load it with a single mmap
+    bool SaveCompiledMap(void) const;
+    // load the landmarks table of the map from disk, or build and save it next to the map file
+    void PrepareDifferentialHeuristic(const Weight = UnitWeight, const std::size_t = 16);
     Report Plan(const Agent&);
     void PlanAllScenarios(void);
+    std::vector<std::vector<Report>> PlanAllAgents(const SolverFactory&, const std::size_t = std::thread::hardware_concurrency());
+    void PlanAllScenarios(const SolverFactory&, const std::size_t = std::thread::hardware_concurrency());
+    // the first agents of the scenario, in its order, skipping agents whose start or goal is taken by a former one
+    std::vector<Agent> SelectAgents(const std::size_t = std::numeric_limits<std::size_t>::max()) const;
+    // plan the first agents of the scenario together, so that they do not collide
+    MultiAgentReport PlanTogether(IMultiAgentPathFinder&, const std::size_t = std::numeric_limits<std::size_t>::max());
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <vector>
 #include "Coordinate.h"
 #include "ISingleAgentPathFinder.h"
+#include "IMultiAgentPathFinder.h"
 
 using std::cout;
 using std::endl;
@@ -61,7 +62,8 @@ static inline void DisplayPath(const std::vector<Coordinate>& path)
 
 static inline void DisplayReport(Report& report)
 {
-    constexpr int PATH = 0, AGENT = 1, NEXPANDED = 2, NGENERAED = 3, NPOPED = 4, NHEAP = 5;
+    constexpr int PATH = 0, AGENT = 1, NEXPANDED = 2, NGENERAED = 3, NPOPED = 4, NHEAP = 5, NMEMORY = 6, NREPAIRED = 7,
+                  NBOUND = 8;
     Path& path = get<PATH>(report);
     const Agent& agent = get<AGENT>(report);
 
@@ -79,9 +81,40 @@ static inline void DisplayReport(Report& report)
     DisplayMessage(White, "Number of generated nodes: ", get<NGENERAED>(report), '\n');
     DisplayMessage(White, "Number of pop operations: ", get<NPOPED>(report), '\n');
     DisplayMessage(White, "Max heap size: ", get<NHEAP>(report), '\n');
+    DisplayMessage(White, "Peak memory: ", get<NMEMORY>(report), " bytes\n");
+    DisplayMessage(White, "Number of repaired nodes: ", get<NREPAIRED>(report), '\n');
+    DisplayMessage(White, "Suboptimality bound: ", get<NBOUND>(report), '\n');
     DisplayPath(path);
 }
 
+static inline void DisplayPath(const std::vector<Coordinate>& path, std::size_t const agent_number)
+{
+    DisplayMessage(Green, "Path of agent number: ", agent_number, " takes ", path.size() - 1, " timesteps:\n");
+    for(std::size_t time = 0; time < path.size(); time++)
+    {
+        DisplayMessage(White, '#', time, '\t', path[time], '\n');
+    }
+}
+
+static inline void DisplayMultiAgentReport(MultiAgentReport& report)
+{
+    constexpr int PATHS = 0, AGENTS = 1, NCOST = 2, NEXPANDED = 3, NSEARCHES = 4, NLOWEXPANDED = 5;
+    const std::size_t number_of_agents = get<AGENTS>(report).size();
+    if(!get<PATHS>(report).empty())
+    {
+        DisplayMessage(Green, "Succeed to plan ", number_of_agents, " agents\n");
+    }
+    else
+    {
+        DisplayMessage(Red, "Failed to plan ", number_of_agents, " agents\n");
+    }
+
+    DisplayMessage(White, "Sum of costs: ", get<NCOST>(report), '\n');
+    DisplayMessage(White, "Number of high-level expanded nodes: ", get<NEXPANDED>(report), '\n');
+    DisplayMessage(White, "Number of low-level searches: ", get<NSEARCHES>(report), '\n');
+    DisplayMessage(White, "Number of low-level expanded nodes: ", get<NLOWEXPANDED>(report), '\n');
+}
+
 static inline void DisplayInvalidCoordinateMessage(Coordinate const& coordinate, int const nrows, int const ncolumns)
 {
     DisplayMessage(Red, "Invalid coordinate supplied: ", coordinate, " Grid shape is: [", nrows, "][", ncolumns, "]\n");
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <iterator>
+#include <string_view>
+#include <thread> // hardware_concurrency()
+#include "Agent.h"
+#include "MappedFile.h"
+
+// A row of a scenario. MapName refers to the mapped file, hence is valid as long as the reader it came from.
+struct ScenarioEntry
+{
+    std::size_t Bucket = 0;
+    std::string_view MapName{};
+    int MapWidth = 0, MapHeight = 0; // 0 in scenarios of version 0.0, which do not list them
+    Agent Task{};
+};
+
+// The agents of a scenario file, grouped by bucket.
+struct Scenario
+{
+    std::string Path{};
+    std::string MapName{}; // of the first row
+    std::vector<std::vector<Agent>> Agents{}; // Agents[i] holds bucket i, up to the largest bucket read
+};
+
+/*
+ * Streaming reader of MovingAI .scen files. The file is memory mapped, and rows are parsed in place with
+ * std::from_chars while iterating, without allocating per row. Rows have one of the following forms:
+ * ver = 1.0 : Bucket  map name  map width  map height  start x-coordinate  start y-coordinate  goal x-coordinate  goal y-coordinate  optimal length
+ * ver = 0.0 : Bucket  map name start x-coordinate  start y-coordinate  goal x-coordinate  goal y-coordinate  optimal length
+ * A malformed row is reported with its line and ends the iteration.
+ */
+class ScenarioReader
+{
+private:
+    MappedFile File;
+    std::string Path;
+    float Version;
+    std::string_view Rows; // content following the version line
+    std::size_t FirstRowLine; // line number of the beginning of Rows
+    mutable bool HasError; // a malformed row was met
+
+    bool ParseVersion(std::string_view&);
+
+public:
+    class Iterator
+    {
+    private:
+        const ScenarioReader* Reader;
+        std::size_t Position, LineNumber;
+        ScenarioEntry Entry;
+
+        void Advance(void);
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = ScenarioEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const ScenarioEntry*;
+        using reference = const ScenarioEntry&;
+
+        Iterator();
+        explicit Iterator(const ScenarioReader*);
+        reference operator*() const { return Entry; }
+        pointer operator->() const { return &Entry; }
+        Iterator& operator++() { Advance(); return *this; }
+        bool operator==(const Iterator& other) const { return Reader == other.Reader; }
+    };
+
+    ScenarioReader();
+    ScenarioReader(const ScenarioReader&) = delete;
+    ScenarioReader& operator=(const ScenarioReader&) = delete;
+    virtual ~ScenarioReader() = default;
+
+    // map the file and parse its version line. fails for a missing file or a version other than 0.0 and 1.0
+    bool Open(const char*);
+    float GetVersion(void) const;
+    // whether the former iteration stopped at a malformed row
+    bool Failed(void) const;
+    // rows are parsed lazily, one per increment
+    Iterator begin(void) const;
+    Iterator end(void) const;
+    // read every row, agents are grouped by their bucket. fails on a malformed row
+    bool Load(Scenario&) const;
+    // load every .scen file of a directory, each file on a worker of its own, sorted by path.
+    // files which fail to load are reported and left out
+    static std::vector<Scenario> LoadDirectory(const char*, const std::size_t = std::thread::hardware_concurrency());
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm> // fill()
+#include "Coordinate.h"
+
+typedef enum NodeStatus
+{
+    ClosedStatus = 1, // the node was expanded, it belongs to the close-set
+    OpenStatus = 2, // the node is queued, tracked by solvers which queue a node again after expanding it (PEA*, ARA*)
+    InconsistentStatus = 4 // the node was reached by a cheaper path after its expansion, and awaits another (ARA*)
+}NodeStatus;
+
+// Grid-indexed search state laid out by access pattern, one slot per map cell addressed by its cell id.
+// Node holds only the fields read by the open-set (f, g and the heap position), so that ordering two nodes touches
+// a single small record. Parents are written when a node is generated or improved and read back only to
+// reconstruct the path, hence they live in an array of their own. The generation stamp of each cell carries the
+// status bits of its node, so that testing whether a cell is generated, open or closed loads one word.
+// Like NodeStore, starting a new search costs a counter increment, and node addresses remain stable for the
+// lifetime of a search. The cell id of a node held by an open-set is recovered from its address.
+template<typename Node>
+class SearchState
+{
+private:
+    static constexpr std::uint32_t STATUS_BITS = 3;
+    static constexpr std::uint32_t STATUS_MASK = (std::uint32_t(1) << STATUS_BITS) - 1;
+    static constexpr std::uint32_t MAX_GENERATION = UINT32_MAX >> STATUS_BITS;
+
+    std::vector<Node> Nodes;
+    std::vector<CellId> Parents;
+    std::vector<std::uint32_t> Stamps; // generation << STATUS_BITS | status bits, of the search which last reached each cell
+    std::uint32_t CurrentGeneration;
+    int NumberOfRows, NumberOfColumns;
+
+public:
+    SearchState(): Nodes(), Parents(), Stamps(), CurrentGeneration(0), NumberOfRows(0), NumberOfColumns(0) {}
+
+    // invalidate all nodes of the previous search. re-allocates only when the grid shape has changed.
+    void Reset(int const rows, int const columns)
+    {
+        if(rows != NumberOfRows || columns != NumberOfColumns)
+        {
+            NumberOfRows = rows;
+            NumberOfColumns = columns;
+            const std::size_t number_of_cells = static_cast<std::size_t>(rows) * columns;
+            Nodes.assign(number_of_cells, Node());
+            Parents.assign(number_of_cells, 0);
+            Stamps.assign(number_of_cells, 0);
+            CurrentGeneration = 0;
+        }
+        if(++CurrentGeneration > MAX_GENERATION)
+        {
+            // generation counter wrapped around, stale stamps may collide with the new generation
+            std::fill(Stamps.begin(), Stamps.end(), 0);
+            CurrentGeneration = 1;
+        }
+    }
+
+    bool Contains(const CellId cell) const
+    {
+        return (Stamps[cell] >> STATUS_BITS) == CurrentGeneration;
+    }
+
+    // whether the node of cell was created during the current search and has the status
+    bool HasStatus(const CellId cell, const NodeStatus status) const
+    {
+        const std::uint32_t stamp = Stamps[cell];
+        return (stamp >> STATUS_BITS) == CurrentGeneration && (stamp & status) != 0;
+    }
+
+    // the node of cell must have been created during the current search
+    void SetStatus(const CellId cell, const NodeStatus status)
+    {
+        Stamps[cell] |= status;
+    }
+
+    void ClearStatus(const CellId cell, const NodeStatus status)
+    {
+        Stamps[cell] &= ~static_cast<std::uint32_t>(status);
+    }
+
+    // bytes held by the state, which covers every cell of the grid whether or not it is reached
+    std::size_t GetMemoryUsage(void) const
+    {
+        return Nodes.capacity() * sizeof(Node) + Parents.capacity() * sizeof(CellId) +
+               Stamps.capacity() * sizeof(std::uint32_t);
+    }
+
+    // return pointer to the node of cell if it was created during the current search, nullptr otherwise
+    Node* Find(const CellId cell)
+    {
+        return Contains(cell) ? &Nodes[cell] : nullptr;
+    }
+
+    // return the node of cell, default-initialize it without any status on first access during the current search
+    Node& operator[](const CellId cell)
+    {
+        if(!Contains(cell))
+        {
+            Nodes[cell] = Node();
+            Stamps[cell] = CurrentGeneration << STATUS_BITS;
+        }
+        return Nodes[cell];
+    }
+
+    CellId GetCellId(const Node* node) const
+    {
+        return static_cast<CellId>(node - Nodes.data());
+    }
+
+    // the parent of a node is undefined until it is set during the current search
+    CellId GetParent(const CellId cell) const
+    {
+        return Parents[cell];
+    }
+
+    void SetParent(const CellId cell, const CellId parent)
+    {
+        Parents[cell] = parent;
+    }
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+
+// Fixed-size pool of workers, each owning a deque of tasks. A worker pops tasks from the back of its own deque,
+// and once it runs dry, steals from the front of the other workers' deques, which balances uneven task costs.
+// A task receives the index of the worker running it, so callers may keep per-worker state (e.g. a solver).
+class ThreadPool
+{
+public:
+    using Task = std::function<void(const std::size_t)>;
+
+private:
+    struct Queue
+    {
+        std::mutex Mutex{};
+        std::deque<Task> Tasks{};
+    };
+
+    std::vector<Queue> Queues; // Queues[i] belongs to Workers[i]
+    std::vector<std::thread> Workers;
+    std::mutex Mutex; // guards sleeping and waking of workers and waiters
+    std::condition_variable HasWork, IsIdle;
+    std::atomic<std::size_t> NumberOfQueuedTasks; // submitted, not yet started
+    std::atomic<std::size_t> NumberOfPendingTasks; // submitted, not yet finished
+    std::size_t NextQueue; // round-robin distribution of submitted tasks
+    bool Stop;
+
+    bool TryPop(const std::size_t, Task&);
+    void Run(const std::size_t);
+
+public:
+    explicit ThreadPool(const std::size_t = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    std::size_t GetNumberOfWorkers(void) const;
+    void Submit(Task);
+    // block until every submitted task has finished
+    void Wait(void);
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "../Common/ISingleAgentPathFinder.h"
+#include "../Common/IMapObserver.h"
+#include "../Common/NodeStore.h"
+#include "DStarLiteNode.h"
+
+class Agent;
+class Map;
+
+/*
+ * D* Lite (Koenig & Likhachev, 2002), an incremental search from the goal towards the start. The g- and rhs-values
+ * of former queries are kept as long as the goal stays the same, so a query after the agent moved or after cells
+ * of the map were blocked or unblocked, repairs only the nodes whose cost to the goal has changed, instead of
+ * searching from scratch. Changes are reported by the map, which the solver observes.
+ * The heuristic must be consistent on every version of the map, which rules out the differential heuristic.
+ */
+class DStarLite : public ISingleAgentPathFinder, public IMapObserver
+{
+public:
+    using Store = NodeStore<DStarLiteNode>;
+
+private:
+    Store Lookup;
+    dstar_lite_heap_t OpenSet;
+    const Map* ObservedMap;
+    std::uint64_t MapVersion; // version of ObservedMap the values are valid for, once ChangedCells are repaired
+    std::vector<Coordinate> ChangedCells; // changed since the last query
+    Coordinate Start, Goal; // of the last query
+    bool IsInitialized;
+    Heuristic InitializedHeuristic; // the values were computed with these heuristic and weight
+    Weight InitializedWeight;
+    double KeyModifier; // km, sum of the heuristic estimations between the consecutive starts
+    bool IsRepairing; // whether changed values are counted as repaired
+    std::uint32_t CurrentQuery;
+    unsigned int NumberOfRepairedNodes;
+
+    DStarLiteNode& GetNode(const Coordinate&);
+    void Touch(DStarLiteNode&);
+    template<typename Visit> void ForEachNeighbor(const Coordinate&, Visit&&) const;
+    template<typename Model> DStarLiteNode::Key CalculateKey(const DStarLiteNode&, const Model&) const;
+    template<typename Model> double BestLookahead(const Coordinate&, const Model&);
+    template<typename Model> void UpdateVertex(DStarLiteNode&, const Model&);
+    template<typename Model> void UpdateLookahead(const Coordinate&, const Model&);
+    template<typename Model> void Initialize(const Model&);
+    template<typename Model> void Repair(const Model&);
+    template<typename Model> bool ComputeShortestPath(const Model&);
+    template<typename Model> Path ReconstructPath(const Model&);
+    template<typename Model> Path Search(const Agent&, const Model&);
+    bool Observe(void);
+    bool IsOutdated(const Agent&) const;
+
+public:
+    DStarLite(const Heuristic = Octile, const Weight = OctileWeight);
+    DStarLite(const Map*, const Heuristic = Octile, const Weight = OctileWeight);
+    DStarLite(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
+    DStarLite(const DStarLite&) = delete;
+    DStarLite& operator=(const DStarLite&) = delete;
+    virtual ~DStarLite();
+    void OnPassabilityChanged(const Map&, const Coordinate&) override;
+    // discard the values of former queries, the next query searches from scratch
+    void Reset(void);
+    Path Solve(const Agent&) override;
+    Report SolveFullReport(const Agent&) override;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "../Common/Coordinate.h"
+#include "../Common/OpenList.h"
+
+class DStarLiteNode;
+struct DStarLiteNodeComparator
+{
+    bool operator() (const DStarLiteNode*, const DStarLiteNode*) const;
+};
+using dstar_lite_heap_t = DaryHeap<DStarLiteNode, DStarLiteNodeComparator, 4>;
+
+class DStarLiteNode
+{
+public:
+    using Key = std::array<double, 2>;
+
+    Coordinate MyCoordinate;
+    double SumOfWeights; // g-value, cost to reach the goal as of the last expansion of the node
+    double Lookahead; // rhs-value, cost to reach the goal through the best successor, based on their g-values
+    Key Priority; // [min(g, rhs) + h(start) + km, min(g, rhs)], valid while the node is queued
+    bool IsQueued; // whether the node is inconsistent, i.e. g != rhs, and belongs to the open-set
+    std::uint32_t RepairStamp; // last query in which g or rhs of the node changed
+    std::size_t HeapIndex; // position of DStarLiteNode in open-set. used for update and erase operations.
+
+    DStarLiteNode();
+    DStarLiteNode(const Coordinate&);
+};
+
+// lexicographic order of keys. first components are sums accumulated in different orders, hence equal ones may differ
+// by rounding, and must still be told apart by the second component.
+bool IsLessKey(const DStarLiteNode::Key&, const DStarLiteNode::Key&);
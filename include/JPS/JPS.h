@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../Common/ISingleAgentPathFinder.h"
+#include "../AStar/AStarNode.h"
+#include "../Common/SearchState.h"
+#include "JumpTable.h"
+
+class Agent;
+class Map;
+
+/*
+ * Jump Point Search (Harabor & Grastien, 2011): A* over jump points only, where symmetric paths are pruned and
+ * straight runs of the grid are skipped instead of generated cell by cell. It assumes the move model of Map,
+ * in which a diagonal move requires only its target cell to be passable, and octile weights, so the weight
+ * setting is ignored. Straight jumps are read from a precomputed JumpTable (JPS+), which is rebuilt whenever
+ * the solver is given another map. Paths are expanded back to full cell sequences.
+ */
+class JPS : public ISingleAgentPathFinder
+{
+public:
+    using Store = SearchState<AStarNode>;
+
+private:
+    Store Lookup;
+    OpenListType OpenList;
+    JumpTable Jumps;
+
+    bool IsPassable(int const, int const) const;
+    unsigned int PruneDirections(const CellId, const Coordinate&) const;
+    bool JumpStraight(const Coordinate&, std::size_t const, const Coordinate&, Coordinate&) const;
+    bool Jump(const Coordinate&, std::size_t const, const Coordinate&, Coordinate&) const;
+    template<typename OpenSet, typename Model> void Expand(AStarNode*, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model>
+    void Generate(AStarNode*, const Coordinate&, const CellId, const Coordinate&, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model> bool Search(const Coordinate, const Coordinate&, const Model&);
+    bool Search(const Coordinate, const Coordinate&);
+    bool Prepare(const Agent&);
+    Path ReconstructPath(const Agent&);
+
+public:
+    JPS(const Heuristic = Octile);
+    JPS(const Map*, const Heuristic = Octile);
+    virtual ~JPS() = default;
+    void SetOpenList(const OpenListType);
+    Path Solve(const Agent&) override;
+    Report SolveFullReport(const Agent&) override;
+};
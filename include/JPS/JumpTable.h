@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "../Common/Coordinate.h"
+
+class Map;
+
+// Precomputed straight jumps of JPS+. For each cell and each straight direction of eight_principle_directions (0..3),
+// a positive distance k means the cell k steps away is the next jump point along the direction, while a distance
+// -k (k >= 0) means k passable cells precede the next obstacle or the map border without any jump point among them.
+class JumpTable
+{
+public:
+    static constexpr std::size_t NUMBER_OF_STRAIGHT_DIRECTIONS = 4;
+
+private:
+    const Map* SourceMap;
+    std::uint64_t MapVersion; // version of SourceMap the table was built for
+    int NumberOfRows, NumberOfColumns;
+    std::vector<int> Distances; // distance of cell c along direction d is at c * NUMBER_OF_STRAIGHT_DIRECTIONS + d
+
+    std::size_t Index(int const, int const, std::size_t const) const;
+
+public:
+    JumpTable();
+    JumpTable(const JumpTable&) = delete;
+    JumpTable& operator=(const JumpTable&) = delete;
+
+    // whether a cell reached by a move along (row_direction, column_direction) has a forced neighbor,
+    // for an 8-connected grid whose diagonal moves require only their target cell to be passable
+    static bool HasForcedNeighbor(const Map&, int const, int const, int const, int const);
+
+    void Build(const Map&);
+    bool IsBuiltFor(const Map&) const;
+    int GetDistance(const Coordinate&, std::size_t const) const;
+};
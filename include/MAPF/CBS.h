@@ -0,0 +1,110 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <limits>
+#include <memory> // shared_ptr, unique_ptr
+#include <thread> // hardware_concurrency()
+#include <condition_variable>
+#include "../Common/IMultiAgentPathFinder.h"
+#include "../Common/OpenList.h"
+#include "SpaceTimeAStar.h"
+#include "ReservationTable.h"
+#include "Conflict.h"
+
+/*
+ * Conflict-Based Search (Sharon et al., 2015). The high-level search is best-first over a constraint tree, whose
+ * nodes hold a set of constraints and a path per agent satisfying the constraints of its agent. The first conflict
+ * of a node is resolved by two children, each forbidding one of the agents its part of the conflict, and only that
+ * agent is replanned. A child shares the paths of all other agents with its parent, and its constraints are its own
+ * constraint prepended to the immutable list of its parent.
+ * Nodes are ordered by the sum of costs, then by their number of conflicts. Optimal with respect to the sum of costs.
+ *
+ * Several threads may expand nodes of the tree at once. They share the open-set under a mutex, while each one
+ * replans with its own low-level solver and keeps the nodes it generates in its own arena. A solution becomes the
+ * incumbent rather than ending the search, which stops once neither the open-set nor a node being expanded by
+ * another thread costs less than the incumbent, since children never cost less than their parent.
+ */
+class CBS : public IMultiAgentPathFinder
+{
+public:
+    struct Constraint
+    {
+        int Agent;
+        Coordinate From, To; // equal for a vertex constraint
+        int Time; // of the vertex, or of the beginning of the move
+    };
+    // persistent list of constraints, shared by all descendants of the node which added its head
+    struct ConstraintList
+    {
+        Constraint Value;
+        std::shared_ptr<ConstraintList> Next;
+
+        ConstraintList(const Constraint&, const std::shared_ptr<ConstraintList>&);
+        ConstraintList(const ConstraintList&) = delete;
+        ConstraintList& operator=(const ConstraintList&) = delete;
+        ~ConstraintList(); // releases the unshared tail iteratively, a deep tree would overflow the call stack
+    };
+
+private:
+    struct Node
+    {
+        std::shared_ptr<ConstraintList> Constraints{};
+        Paths Solution{};
+        unsigned long Cost = 0;
+        std::size_t NumberOfConflicts = 0;
+        Conflict FirstConflict{};
+        std::size_t HeapIndex = 0;
+    };
+    struct NodeComparator
+    {
+        bool operator() (const Node*, const Node*) const;
+    };
+    using constraint_tree_heap_t = DaryHeap<Node, NodeComparator, 4>;
+
+    // state owned by a single thread of the search
+    struct Worker
+    {
+        SpaceTimeAStar LowLevel{};
+        ReservationTable Reservations{};
+        ConflictDetector Detector{};
+        std::deque<Node> Tree{}; // nodes generated by this thread
+        unsigned int NumberOfLowLevelSearches = 0;
+        unsigned long NumberOfLowLevelExpandedNodes = 0;
+    };
+
+    std::vector<std::unique_ptr<Worker>> Workers;
+    std::shared_ptr<GoalDistanceCache> Distances; // shared by the low-level solvers of all workers
+    std::size_t NumberOfThreads;
+    std::size_t NodeLimit;
+    // shared search state, guarded by Mutex
+    std::mutex Mutex;
+    std::condition_variable HasWork;
+    constraint_tree_heap_t OpenSet;
+    const Node* Incumbent;
+    std::size_t NumberOfBusyWorkers;
+    bool IsDone;
+
+    bool Replan(Worker&, Node&, const int, const std::vector<Agent>&);
+    void Evaluate(Worker&, Node&);
+    Node* Branch(Worker&, const Node&, const Constraint&, const std::vector<Agent>&);
+    Node* Pop(void);
+    void Search(Worker&, const std::vector<Agent>&);
+    void PrepareWorkers(void);
+    void CollectStatistics(void);
+
+public:
+    CBS();
+    CBS(const Map*);
+    CBS(const CBS&) = delete;
+    CBS& operator=(const CBS&) = delete;
+    virtual ~CBS() = default;
+    void SetDistanceCache(const std::shared_ptr<GoalDistanceCache>&);
+    // the search gives up after expanding the given number of constraint tree nodes
+    void SetNodeLimit(const std::size_t = std::numeric_limits<std::size_t>::max());
+    // number of threads expanding constraint tree nodes, 1 runs the search on the calling thread only
+    void SetNumberOfThreads(const std::size_t = std::thread::hardware_concurrency());
+    Paths Solve(const std::vector<Agent>&) override;
+    MultiAgentReport SolveFullReport(const std::vector<Agent>&) override;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "../Common/Coordinate.h"
+#include "../Common/IMultiAgentPathFinder.h" // Paths
+
+// Two agents at the same cell at the same timestep (vertex conflict), or two agents swapping their cells
+// between Time and Time + 1 (swap conflict), the first agent moving from FirstCell to SecondCell.
+struct Conflict
+{
+    int FirstAgent = -1, SecondAgent = -1;
+    Coordinate FirstCell{}, SecondCell{};
+    int Time = 0;
+    bool IsSwap = false;
+};
+
+// Finds the conflicts between paths, timestep by timestep. The occupant of each cell is kept in a grid-indexed table
+// stamped with the timestep it was written at, so moving on to the next timestep costs a counter increment.
+class ConflictDetector
+{
+private:
+    int NumberOfColumns;
+    std::vector<int> Occupants; // agent at each cell
+    std::vector<std::uint32_t> Stamps; // scan in which each cell of Occupants was written
+    std::uint32_t CurrentStamp;
+
+    std::uint32_t CellIndex(const Coordinate&) const;
+    static const Coordinate& GetCoordinate(const Path&, const std::size_t);
+
+public:
+    ConflictDetector();
+    // adapt the tables to the shape of the grid, re-allocates only when it has changed
+    void Reset(const int, const int);
+    // number of conflicts among the paths. the first one found, scanning the timesteps in order, is stored in conflict
+    std::size_t Detect(const Paths&, Conflict&);
+};
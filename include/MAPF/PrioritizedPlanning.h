@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../Common/IMultiAgentPathFinder.h"
+#include "SpaceTimeAStar.h"
+#include "ReservationTable.h"
+
+/*
+ * Prioritized Planning: agents are planned one at a time, in the order they are given, each one avoiding the
+ * reserved paths of the agents before it. Fast, but incomplete and suboptimal, since an agent is never delayed
+ * in favor of a later one.
+ */
+class PrioritizedPlanning : public IMultiAgentPathFinder
+{
+private:
+    SpaceTimeAStar LowLevel;
+    ReservationTable Reservations;
+
+public:
+    PrioritizedPlanning();
+    PrioritizedPlanning(const Map*);
+    virtual ~PrioritizedPlanning() = default;
+    void SetDistanceCache(const std::shared_ptr<GoalDistanceCache>&);
+    Paths Solve(const std::vector<Agent>&) override;
+    MultiAgentReport SolveFullReport(const std::vector<Agent>&) override;
+};
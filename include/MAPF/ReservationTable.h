@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <unordered_set>
+#include <unordered_map>
+#include "../Common/Coordinate.h"
+#include "../Common/ISingleAgentPathFinder.h" // Path
+
+/*
+ * Timesteps at which cells may not be occupied (vertex constraints) and moves may not be taken (move constraints),
+ * as seen by a single agent. Constraints are hashed per timestep, so a lookup costs an index and a hash probe.
+ * A move constraint at t forbids leaving its source cell towards its target cell at t, arriving there at t + 1.
+ * A permanent constraint keeps a cell occupied from a timestep on, as done by an agent which has reached its goal.
+ */
+class ReservationTable
+{
+public:
+    static constexpr int FOREVER = std::numeric_limits<int>::max();
+
+private:
+    int NumberOfColumns;
+    std::vector<std::unordered_set<std::uint32_t>> Vertices; // cells of each timestep
+    std::vector<std::unordered_set<std::uint64_t>> Moves; // (source, target) cell pairs of each timestep
+    std::unordered_map<std::uint32_t, int> Permanent; // cell, first timestep of its occupation
+    std::unordered_map<std::uint32_t, int> LatestVertexTimes; // cell, last timestep it is constrained at
+    int LatestTime;
+
+    std::uint32_t CellIndex(const Coordinate&) const;
+    std::uint64_t MoveIndex(const Coordinate&, const Coordinate&) const;
+
+public:
+    ReservationTable(const int = 0);
+
+    void Clear(const int);
+    void AddVertexConstraint(const Coordinate&, const int);
+    void AddMoveConstraint(const Coordinate&, const Coordinate&, const int);
+    void AddPermanentConstraint(const Coordinate&, const int);
+    // reserve the path of an agent which stays at its last cell once it ends: its cells at their timesteps,
+    // the moves which would swap places with it, and its last cell from then on
+    void Reserve(const Path&);
+
+    bool IsVertexFree(const Coordinate&, const int) const;
+    bool IsMoveFree(const Coordinate&, const Coordinate&, const int) const;
+    // last timestep with a constraint, -1 if there is none. from the next one on the table no longer changes
+    int GetLatestTime(void) const;
+    // last timestep at which the cell is constrained, -1 if never, FOREVER if it is permanently occupied
+    int GetLatestVertexTime(const Coordinate&) const;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <deque>
+#include <memory> // shared_ptr
+#include <cstdint>
+#include <unordered_map>
+#include "../Common/ISingleAgentPathFinder.h"
+#include "../Common/GoalDistanceCache.h"
+#include "SpaceTimeNode.h"
+#include "ReservationTable.h"
+
+class Agent;
+class Map;
+
+/*
+ * A* over (cell, timestep) states, which avoids the cells and moves of a ReservationTable. An agent either waits
+ * or moves to a neighboring cell in each timestep, and stays at its goal once it ends its path, hence the goal is
+ * reached only at a timestep after which the goal is never constrained. The path holds the cell of every timestep.
+ * States beyond the last constrained timestep are merged per cell, since the table no longer changes there, which
+ * keeps the state space finite and lets an unsolvable query exhaust it.
+ * Estimations are the exact unconstrained distances to the goal, taken from a GoalDistanceCache of unit weights,
+ * so replanning an agent under new constraints, as CBS does, computes the table of its goal once.
+ */
+class SpaceTimeAStar : public ISingleAgentPathFinder
+{
+private:
+    std::deque<SpaceTimeNode> Nodes; // nodes of the current search, their addresses are stable
+    std::unordered_map<std::uint64_t, SpaceTimeNode*> Lookup; // state index, node
+    std::shared_ptr<GoalDistanceCache> Distances;
+    std::shared_ptr<const GoalDistanceCache::Table> GoalDistances; // table of the current goal
+    const ReservationTable* Constraints; // set by the user
+    const ReservationTable* Active; // constraints of the current search, Unconstrained when none are set
+    ReservationTable Unconstrained;
+    int Horizon; // first timestep after the last constrained one
+    std::uint64_t NumberOfCells;
+    SpaceTimeNode* GoalNode;
+
+    std::size_t CellIndex(const Coordinate&) const;
+    std::uint64_t StateIndex(const Coordinate&, const int) const;
+    bool IsGoal(const SpaceTimeNode&, const Coordinate&, const int) const;
+    void Generate(SpaceTimeNode*, const Coordinate&, space_time_heap_t&);
+    void Expand(SpaceTimeNode*, space_time_heap_t&);
+    bool Search(const Coordinate&, const Coordinate&);
+    bool Prepare(const Agent&);
+    Path ReconstructPath(void) const;
+    std::size_t GetMemoryUsage(void) const;
+
+public:
+    SpaceTimeAStar();
+    SpaceTimeAStar(const Map*);
+    SpaceTimeAStar(const SpaceTimeAStar&) = delete;
+    SpaceTimeAStar& operator=(const SpaceTimeAStar&) = delete;
+    virtual ~SpaceTimeAStar() = default;
+    // share the distance tables with other solvers of the same map, a private cache is created otherwise
+    void SetDistanceCache(const std::shared_ptr<GoalDistanceCache>&);
+    // constraints of the following queries, nullptr for none. the table must outlive the queries.
+    void SetReservationTable(const ReservationTable*);
+    Path Solve(const Agent&) override;
+    Report SolveFullReport(const Agent&) override;
+};
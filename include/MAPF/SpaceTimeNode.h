@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../Common/Coordinate.h"
+#include "../Common/OpenList.h"
+
+class SpaceTimeNode;
+struct SpaceTimeNodeComparator
+{
+    bool operator() (const SpaceTimeNode*, const SpaceTimeNode*) const;
+};
+using space_time_heap_t = DaryHeap<SpaceTimeNode, SpaceTimeNodeComparator, 4>;
+
+// A cell at a timestep. Every action, moving or waiting, takes one timestep, hence the g-value equals Time.
+class SpaceTimeNode
+{
+public:
+    Coordinate MyCoordinate;
+    int Time;
+    SpaceTimeNode* Parent; // the node this one was reached from, nullptr for the root
+    double StaticValue; // f-value, Time + estimated number of timesteps to reach the goal
+    bool IsExpanded;
+    std::size_t HeapIndex; // position of SpaceTimeNode in open-set. used for decrease key operation.
+
+    SpaceTimeNode();
+    SpaceTimeNode(const Coordinate&, const int, SpaceTimeNode* const, const double);
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <atomic>
+#include <memory> // unique_ptr
+#include "../Common/ISingleAgentPathFinder.h"
+#include "../AStar/AStarNode.h"
+#include "../Common/SearchState.h"
+
+class Agent;
+class Map;
+
+typedef enum SearchDirection
+{
+    Forward, // from the start towards the goal
+    Backward, // from the goal towards the start, over reversed moves
+    NSearchDirection
+}SearchDirection;
+
+/*
+ * MM, bidirectional heuristic search that meets in the middle (Holte et al., 2016). Each direction orders its
+ * open-set by the priority max(f, 2g), so neither search expands a node beyond half of the optimal cost.
+ * Whenever a node is reached by both directions, the path through it bounds the optimal cost from above (U),
+ * while the smallest priority of the two open-sets bounds it from below, and the search stops once U is no
+ * greater than that priority. The heuristic must be consistent and symmetric, H(a, b) == H(b, a).
+ * Both searches may run concurrently on two threads, in which case they share their g-values through
+ * per-cell atomic arrays, and nodes are stored per direction in SearchStates owned by their own thread.
+ */
+class MM : public ISingleAgentPathFinder
+{
+public:
+    using Store = SearchState<AStarNode>;
+
+private:
+    // state of the search in one direction
+    struct Frontier
+    {
+        Store Lookup{};
+        Coordinate Root{}, Target{};
+        unsigned int NumberOfExpandedNodes = 0, NumberOfGeneratedNodes = 0, NumberOfPopOperations = 0;
+        unsigned long MaxHeapSize = 0;
+        std::unique_ptr<std::atomic<double>[]> Costs{}; // concurrent search only, g-value of each cell
+        std::atomic<double> MinPriority = 0; // concurrent search only, smallest priority of the open-set
+    };
+
+    std::array<Frontier, NSearchDirection> Frontiers;
+    OpenListType OpenList;
+    bool IsConcurrent;
+    std::size_t NumberOfCells; // capacity of the Costs arrays
+    // cheapest path found so far, through Meeting. updated under the mutex, read without it
+    std::atomic<double> BestCost;
+    CellId Meeting;
+    std::mutex MeetingMutex;
+    std::atomic<bool> IsDone;
+
+    template<bool Concurrent> double GetOppositeCost(const SearchDirection, const CellId);
+    template<bool Concurrent> void SetCost(const SearchDirection, const CellId, const double);
+    template<bool Concurrent> void UpdateMeeting(const CellId, const double);
+    template<bool Concurrent, typename OpenSet, typename Model>
+    void Generate(const SearchDirection, AStarNode*, const Coordinate&, const CellId, const Coordinate&, OpenSet&, const Model&);
+    template<bool Concurrent, typename OpenSet, typename Model>
+    void Expand(const SearchDirection, AStarNode*, OpenSet&, const Model&);
+    template<bool Concurrent, typename OpenSet, typename Model>
+    void Initialize(const SearchDirection, const Coordinate&, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model> void Advance(const SearchDirection, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model> bool Search(const Coordinate, const Coordinate&, const Model&);
+    template<typename OpenSet, typename Model> bool SearchConcurrently(const Coordinate, const Coordinate&, const Model&);
+    bool Search(const Coordinate, const Coordinate&);
+    bool Prepare(const Agent&);
+    Path ReconstructPath(const Agent&);
+    void CollectStatistics(void);
+
+public:
+    MM(const Heuristic = Euclidean, const Weight = UnitWeight);
+    MM(const Map*, const Heuristic = Euclidean, const Weight = UnitWeight);
+    MM(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
+    MM(const MM&) = delete;
+    MM& operator=(const MM&) = delete;
+    virtual ~MM() = default;
+    void SetOpenList(const OpenListType);
+    // run the forward search on a second thread, alongside the backward search
+    void SetConcurrent(const bool);
+    Path Solve(const Agent&) override;
+    Report SolveFullReport(const Agent&) override;
+};
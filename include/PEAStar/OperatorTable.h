@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm> // sort(), max()
+#include <type_traits>
+#include "../Common/Coordinate.h"
+#include "../Common/CostPolicies.h"
+#include "../Common/Directions.h"
+
+/*
+ * Operator selection function of Enhanced Partial Expansion A* over 8-connected grids. The change of f along a move,
+ * W(n, n') + H(n', goal) - H(n, goal), depends only on the move and on the class of n with respect to the goal:
+ * the signs of the row and column offsets to the goal, and the difference of their magnitudes clamped to [-2, 2].
+ * Manhattan, Chebyshev and octile estimations are linear within a class and along any single move, so the changes
+ * are computed once per search on a representative cell of each class, and the moves of each class are grouped by
+ * their change of f in increasing order. Negative changes, of inconsistent estimations, are grouped with 0.
+ */
+class OperatorTable
+{
+public:
+    static constexpr std::size_t NUMBER_OF_CLASSES = 3 * 3 * 5;
+    static constexpr std::size_t MAX_GROUPS = 8;
+
+    struct Group
+    {
+        double Delta; // change of f along the moves of the group
+        std::uint8_t Directions; // bit i stands for eight_principle_directions[i]
+    };
+
+private:
+    std::array<std::array<Group, MAX_GROUPS>, NUMBER_OF_CLASSES> Groups;
+    std::array<std::uint8_t, NUMBER_OF_CLASSES> NumberOfGroups;
+
+public:
+    OperatorTable();
+
+    static std::size_t ClassOf(const Coordinate&, const Coordinate&);
+    template<typename Model> void Build(const Model&);
+    // index of the first group, from the given one on, that holds a move of mask. the number of groups if none does
+    std::size_t Find(const std::size_t, const std::size_t, const std::uint8_t) const;
+    std::size_t GetNumberOfGroups(const std::size_t) const;
+    const Group& GetGroup(const std::size_t, const std::size_t) const;
+};
+
+// whether the change of f under Model is determined by the class, which excludes Euclidean, differential and
+// user supplied estimations, as well as user supplied weights
+template<typename Model>
+struct IsOperatorSelectable : std::false_type {};
+
+template<typename HeuristicPolicy, typename WeightPolicy>
+struct IsOperatorSelectable<CostModel<HeuristicPolicy, WeightPolicy>> : std::bool_constant<
+    (std::is_same_v<HeuristicPolicy, ManhattanPolicy> || std::is_same_v<HeuristicPolicy, ChebyshevPolicy> ||
+     std::is_same_v<HeuristicPolicy, OctilePolicy>) &&
+    (std::is_same_v<WeightPolicy, UnitWeightPolicy> || std::is_same_v<WeightPolicy, OctileWeightPolicy>)> {};
+
+template<typename Model>
+void OperatorTable::Build(const Model& model)
+{
+    constexpr double TOLERANCE = 1e-9;
+    // goal offsets of up to 4 rows and columns cover every class
+    constexpr int RADIUS = 4;
+    const Coordinate node(RADIUS, RADIUS);
+    std::array<bool, NUMBER_OF_CLASSES> is_built = {};
+    for(int row = 0; row <= 2 * RADIUS; row++)
+    {
+        for(int column = 0; column <= 2 * RADIUS; column++)
+        {
+            const Coordinate goal(row, column);
+            const std::size_t cls = ClassOf(node, goal);
+            if(is_built[cls])
+            {
+                continue;
+            }
+            is_built[cls] = true;
+
+            std::array<std::pair<double, std::size_t>, 8> moves;
+            const double estimation = model.H(node, goal);
+            for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+            {
+                const Coordinate successor(node.GetRow() + eight_principle_directions[i].GetRow(),
+                                           node.GetColumn() + eight_principle_directions[i].GetColumn());
+                const double delta = model.W(node, successor) + model.H(successor, goal) - estimation;
+                moves[i] = {std::max(delta, 0.0), i};
+            }
+            std::sort(moves.begin(), moves.end());
+
+            std::uint8_t& number_of_groups = NumberOfGroups[cls];
+            number_of_groups = 0;
+            for(const auto& [delta, direction] : moves)
+            {
+                if(number_of_groups == 0 || delta > Groups[cls][number_of_groups - 1].Delta + TOLERANCE)
+                {
+                    Groups[cls][number_of_groups++] = {delta, 0};
+                }
+                Groups[cls][number_of_groups - 1].Directions |= std::uint8_t(1) << direction;
+            }
+        }
+    }
+}
@@ -2,40 +2,71 @@
 
 #include "../Common/ISingleAgentPathFinder.h"
 #include "PEAStarNode.h"
-#include <unordered_map>
+#include "OperatorTable.h"
+#include "../Common/SearchState.h"
 
 class Agent;
 class Map;
 
+typedef enum ExpansionMode
+{
+    // every successor is generated on each expansion, those above the stored value are left out of the open-set
+    PartialExpansion,
+    // EPEA*, an operator selection function generates only the successors of the next change of f. requires a
+    // Manhattan, Chebyshev or octile heuristic with unit or octile weight, PartialExpansion is used otherwise
+    EnhancedPartialExpansion
+}ExpansionMode;
+
 struct PEAStarNodeComparator
 {
     bool operator() (const PEAStarNode*, const PEAStarNode*) const;
 };
+// breaks F-ties toward the larger g-value, see DeepTieBreak
+struct DeepPEAStarNodeComparator
+{
+    bool operator() (const PEAStarNode*, const PEAStarNode*) const;
+};
 
 class PEAStar : public ISingleAgentPathFinder
 {
 public:
-    using HashMap = std::unordered_map<Coordinate, PEAStarNode, CoordinateHasher>;
-    using binomial_heap_t = boost::heap::binomial_heap<PEAStarNode*, boost::heap::compare<PEAStarNodeComparator>>;
+    using Store = SearchState<PEAStarNode>;
+    using quaternary_heap_t = DaryHeap<PEAStarNode, PEAStarNodeComparator, 4>;
+    using fibonacci_heap_t = FibonacciHeap<PEAStarNode, PEAStarNodeComparator>;
+    using deep_quaternary_heap_t = DaryHeap<PEAStarNode, DeepPEAStarNodeComparator, 4>;
+    using deep_fibonacci_heap_t = FibonacciHeap<PEAStarNode, DeepPEAStarNodeComparator>;
+    using bucket_queue_t = BucketQueue<PEAStarNode, false>;
+    using integral_bucket_queue_t = BucketQueue<PEAStarNode, true>;
 
 private:
     // open_set contains pointers to Nodes in the Lookup table
-    HashMap Lookup;
-
-    bool IsNodeExpanded(const Coordinate&);
-    bool IsNodeWithinOpenSet(const Coordinate&);
-    bool IsLegalSuccessor(const Coordinate&);
-    void Collapse(PEAStarNode*, const double, binomial_heap_t&);
-    void Expand(PEAStarNode*, const Coordinate&, binomial_heap_t&);
-    double Generate(PEAStarNode*, const Coordinate&, const Coordinate&, binomial_heap_t&);
+    Store Lookup;
+    OpenListType OpenList;
+    ExpansionMode Expansion;
+    OperatorTable Operators; // EnhancedPartialExpansion only, built for the cost model of each search
+
+    bool IsNodeExpanded(const CellId);
+    bool IsNodeWithinOpenSet(const CellId);
+    bool IsLegalSuccessor(const CellId);
+    template<typename OpenSet> void Collapse(PEAStarNode*, const double, OpenSet&);
+    template<typename OpenSet, typename Model> void Expand(PEAStarNode*, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model>
+    double Generate(PEAStarNode*, const Coordinate&, const CellId, const Coordinate&, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model> void ExpandEnhanced(PEAStarNode*, const Coordinate&, OpenSet&, const Model&);
+    template<typename OpenSet, typename Model>
+    void GenerateEnhanced(PEAStarNode*, const Coordinate&, const CellId, const Coordinate&, const Coordinate&, OpenSet&,
+                          const Model&);
+    template<typename OpenSet, typename Model> bool Search(const Coordinate, const Coordinate&, const Model&);
     bool Search(const Coordinate, const Coordinate&);
     Path ReconstructPath(const Agent&);
 
 public:
-    PEAStar(const Heuristic = Euclidean);
-    PEAStar(Map*, const Heuristic = Euclidean);
-    PEAStar(Map*, const HeuristicFunction&, const WeightFunction&);
+    PEAStar(const Heuristic = Euclidean, const Weight = UnitWeight);
+    PEAStar(const Map*, const Heuristic = Euclidean, const Weight = UnitWeight);
+    PEAStar(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
     virtual ~PEAStar() = default;
+    void SetOpenList(const OpenListType);
+    void SetExpansionMode(const ExpansionMode);
     Path Solve(const Agent&) override;
     Report SolveFullReport(const Agent&) override;
 };
\ No newline at end of file
@@ -1,29 +1,27 @@
 #pragma once
 
 #include "../Common/Coordinate.h"
-#include <boost/heap/binomial_heap.hpp>
+#include <cstdint>
 
+// fields of a node read by the open-set and by the expansion. the cell, parent and status of a node are kept by
+// SearchState
 class PEAStarNode
 {
 public:
-    Coordinate MyCoordinate, Parent;
     double StaticValue; // f-value, estimated cost of the cheapest path (root..PEAStarNode..goal)
     double StoredValue; // F-value, least f-value of successors, that was propagated to this RbfsNode by a collapse action.
     double SumOfWeights; // g-value, the cheapest sum of weights to reach this PEAStarNode
-    bool IsExpanded; // whether this PEAStarNode is already being popped from open set (=belongs to close-set)
-    bool IsOpen;// whether this PEAStarNode has been inserted to open-set
+    std::uint32_t HeapIndex; // position of PEAStarNode in open-set, maintained by the open-set.
+    std::uint8_t OperatorGroup; // EPEA* only, group of operators applied by the next expansion of this PEAStarNode
 
     PEAStarNode();
-    PEAStarNode(const Coordinate&);
-    PEAStarNode(const Coordinate&, const double, const double, const double);
-    PEAStarNode(const Coordinate&, const Coordinate&, const double, const double, const double);
-    PEAStarNode(const PEAStarNode&);
-    PEAStarNode(PEAStarNode&&) noexcept ;
-    virtual ~PEAStarNode() = default;
+    PEAStarNode(const double, const double, const double);
 
     friend std::ostream& operator<<(std::ostream&, const PEAStarNode&);
-    PEAStarNode& operator = (const PEAStarNode&);
-    PEAStarNode& operator = (PEAStarNode&&) noexcept ;
-    bool operator == (const PEAStarNode&) const;
-    bool operator != (const PEAStarNode&) const;
-};
\ No newline at end of file
+};
+
+// open-sets order PEAStarNodes by their F-value, so that a collapsed PEAStarNode waits for its next expansion
+inline double GetQueueKey(const PEAStarNode& node)
+{
+    return node.StoredValue;
+}
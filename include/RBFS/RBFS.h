@@ -1,8 +1,9 @@
 #pragma once
 
+#include <deque>
 #include "../Common/ISingleAgentPathFinder.h"
 #include "RbfsNode.h"
-#include <unordered_map>
+#include "../Common/NodeStore.h"
 
 class Agent;
 
@@ -12,30 +13,67 @@ typedef enum Status
     Failed
 }Status;
 
+typedef enum MemoryMode
+{
+    // every generated node is kept in the grid-indexed store, together with its stored value, and is generated
+    // again only when reached by a cheaper path, which detaches it from its former predecessor. finds the cheapest
+    // path under an admissible heuristic, fast, but memory grows with the explored region. the default mode.
+    RetainedMemory,
+    // only the nodes of the current path and their successors are kept, as RBFS intends. a cell is generated again
+    // whenever it is reached, except by a path which already passes through it. finds the cheapest path under an
+    // admissible heuristic, at the cost of re-expanding transpositions, which grows exponentially with obstacles.
+    LinearMemory
+}MemoryMode;
+
+/*
+ * Recursive Best-First Search, run iteratively over an explicit stack of frames, one frame per node of the current
+ * path, so the depth of a path is not bounded by the call stack. Each node keeps its successors in an inline array
+ * of at most 8, reordered by insertion after every collapse action.
+ */
 class RBFS : public ISingleAgentPathFinder
 {
 public:
-    using HashMap = std::unordered_map<Coordinate, RbfsNode, CoordinateHasher>;
+    using Store = NodeStore<RbfsNode>;
     using Solution = std::tuple<double, Status>;
 
 private:
-    HashMap Lookup;
+    struct Frame
+    {
+        RbfsNode* Node;
+        double Bound; // the stored value of Node's best successor may not exceed it
+    };
+    using Successors = std::array<RbfsNode, RbfsNode::MAX_SUCCESSORS>;
+
+    MemoryMode Memory;
+    Store Lookup; // RetainedMemory only
+    RbfsNode Root; // LinearMemory only, the successors of frame i are owned by Children[i]
+    std::deque<Successors> Children;
+    std::vector<bool> OnPath; // LinearMemory only, one bit per cell, set for the nodes of the current path
+    std::vector<Frame> Frames;
+    std::size_t MaxDepth;
 
-    bool IsGenerated(const Coordinate&);
+    bool IsGenerated(const CellId);
     bool IsNodeExpanded(const RbfsNode&) const;
-    bool IsLegalSuccessor(const Coordinate&);
+    bool IsLegalSuccessor(const CellId, const CellId, const double);
     bool IsSolutionFound(const Solution&) const;
-    double ExtractBound(const Solution& sol) const;
-    void Expand(const Coordinate, const Coordinate&);
-    void Generate(RbfsNode&, const Coordinate&, const Coordinate&);
+    template<typename Model> void Expand(RbfsNode&, const Coordinate&, const Model&);
+    template<typename Model> void ExpandLinear(RbfsNode&, const Coordinate&, const Model&);
+    template<typename Model>
+    void Generate(RbfsNode&, RbfsNode&, const CellId, const Coordinate&, const double, const Coordinate&, const Model&);
+    template<typename Model> void Push(RbfsNode&, const double, const Coordinate&, const Model&);
+    void Pop(void);
+    template<typename Model> Solution Search(const Coordinate, const double, const Coordinate&, const Model&);
     Solution Search(const Coordinate, const double, const Coordinate&);
+    bool Prepare(const Agent&);
     Path ReconstructPath(const Agent&);
+    std::size_t GetMemoryUsage(void) const;
 
 public:
-    RBFS(const Heuristic = Euclidean);
-    RBFS(Map*, const Heuristic = Euclidean);
-    RBFS(Map*, const HeuristicFunction&, const WeightFunction&);
+    RBFS(const Heuristic = Euclidean, const Weight = UnitWeight);
+    RBFS(const Map*, const Heuristic = Euclidean, const Weight = UnitWeight);
+    RBFS(const Map*, const HeuristicFunction&, const WeightFunction&, const CostStructure = ArbitraryCost);
     virtual ~RBFS() = default;
+    void SetMemoryMode(const MemoryMode);
     Path Solve(const Agent&) override;
     Report SolveFullReport(const Agent&) override;
-};
\ No newline at end of file
+};
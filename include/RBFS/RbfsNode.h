@@ -1,29 +1,37 @@
 #pragma once
 #include "../Common/Coordinate.h"
-#include <vector>
+#include "../Common/OpenList.h" // TieBreak
+#include <array>
+#include <cstdint>
 
 class RbfsNode
 {
 public:
-    Coordinate MyCoordinate, Parent;
+    static constexpr std::size_t MAX_SUCCESSORS = 8; // a grid cell has at most 8 neighbors
+
+    CellId Id, Parent; // cell of this RbfsNode and of its predecessor on the current path
     double StaticValue; // f-value, estimated cost of the cheapest path (root..RbfsNode..goal)
     double StoredValue; // F-value, least f-value of successors, that was propagated to this RbfsNode by a collapse action.
     double SumOfWeights; // g-value, the cheapest sum of weights to reach this RbfsNode
-    std::vector<RbfsNode*> Successors;
+    std::array<RbfsNode*, MAX_SUCCESSORS> Successors; // ordered by RbfsNodeComparator, best first
+    std::uint8_t NumberOfSuccessors;
 
     RbfsNode();
-    RbfsNode(const Coordinate&);
-    RbfsNode(const Coordinate&, const double, const double, const double);
-    RbfsNode(const Coordinate&, const Coordinate&, const double, const double, const double);
-    RbfsNode(const RbfsNode&);
-    RbfsNode(RbfsNode&&) noexcept ;
-    virtual ~RbfsNode() = default;
+    RbfsNode(const CellId);
+    RbfsNode(const CellId, const double, const double, const double);
+    RbfsNode(const CellId, const CellId, const double, const double, const double);
 
     friend std::ostream& operator<<(std::ostream&, const RbfsNode&);
-    RbfsNode& operator = (const RbfsNode&);
-    RbfsNode& operator = (RbfsNode&&) noexcept ;
     bool operator == (const RbfsNode&) const;
     bool operator != (const RbfsNode&) const;
 
-    static bool RbfsNodeComparator(const RbfsNode*, const RbfsNode*);
+    void AddSuccessor(RbfsNode*);
+    // keeps the order of the others, nothing is done if it is not a successor
+    void RemoveSuccessor(const RbfsNode*);
+    void SortSuccessors(const TieBreak);
+    // restore the order after the stored value of the best successor has been raised by a collapse action
+    void ReorderBestSuccessor(const TieBreak);
+
+    // whether n1 precedes n2, ties of stored values broken as given
+    static bool RbfsNodeComparator(const RbfsNode*, const RbfsNode*, const TieBreak);
 };
\ No newline at end of file
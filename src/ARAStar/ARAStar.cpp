@@ -0,0 +1,257 @@
+#include "../../include/ARAStar/ARAStar.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Agent.h"
+#include "../../include/Common/Printer.h"
+#include "../../include/Common/Directions.h"
+#include <cmath>
+#include <bit> // countr_zero()
+
+// the clock is read once per this many pop operations
+constexpr unsigned int DEADLINE_CHECK_INTERVAL = 64;
+
+ARAStar::ARAStar(const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(heuristic, weight), Lookup(),
+    OpenSet(), Inconsistent(), Closed(), InitialSuboptimality(3), SuboptimalityStep(0.5),
+    TimeBudget(std::chrono::milliseconds(20)), Suboptimality(3), AchievedBound(0) {}
+
+ARAStar::ARAStar(const Map* map, const Heuristic heuristic, const Weight weight):
+    ISingleAgentPathFinder(map, heuristic, weight), Lookup(), OpenSet(), Inconsistent(), Closed(), InitialSuboptimality(3),
+    SuboptimalityStep(0.5), TimeBudget(std::chrono::milliseconds(20)), Suboptimality(3), AchievedBound(0) {}
+
+ARAStar::ARAStar(const Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight, const CostStructure costs):
+    ISingleAgentPathFinder(map, heuristic, weight, costs), Lookup(), OpenSet(), Inconsistent(), Closed(),
+    InitialSuboptimality(3), SuboptimalityStep(0.5), TimeBudget(std::chrono::milliseconds(20)), Suboptimality(3),
+    AchievedBound(0) {}
+
+void ARAStar::SetSuboptimalitySchedule(const double initial_suboptimality, const double suboptimality_step)
+{
+    InitialSuboptimality = std::max(initial_suboptimality, 1.0);
+    // a step of 0 or less would never lower the factor, it is lowered straight to 1 instead
+    SuboptimalityStep = (suboptimality_step > 0) ? suboptimality_step : InitialSuboptimality;
+}
+
+void ARAStar::SetTimeBudget(const Clock::duration time_budget)
+{
+    TimeBudget = time_budget;
+}
+
+bool ARAStar::IsDeadlinePassed(const Clock::time_point deadline) const
+{
+    return (NumberOfPopOperations % DEADLINE_CHECK_INTERVAL) == 0 && Clock::now() >= deadline;
+}
+
+template<typename Model>
+void ARAStar::Generate(AStarNode* root_node, const Coordinate& root_coordinate, const CellId successor,
+                       const Coordinate& successor_coordinate, const Coordinate& goal, const Model& model)
+{
+    AStarNode* successor_node = Lookup.Find(successor);
+    const double successor_sum_of_weights = root_node->SumOfWeights + model.W(root_coordinate, successor_coordinate);
+    if(successor_node == nullptr)
+    {
+        NumberOfGeneratedNodes++;
+        AStarNode& node = Lookup[successor];
+        node = {successor_sum_of_weights + Suboptimality * model.H(successor_coordinate, goal), successor_sum_of_weights};
+        Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+        OpenSet.push(&node);
+        Lookup.SetStatus(successor, OpenStatus);
+        return;
+    }
+    if(successor_node->SumOfWeights <= successor_sum_of_weights)
+    {
+        return;
+    }
+    successor_node->SumOfWeights = successor_sum_of_weights;
+    Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+    if(Lookup.HasStatus(successor, ClosedStatus))
+    {
+        // expanded again only by the next step, which queues it under its next key
+        if(!Lookup.HasStatus(successor, InconsistentStatus))
+        {
+            Lookup.SetStatus(successor, InconsistentStatus);
+            Inconsistent.push_back(successor);
+        }
+        return;
+    }
+    successor_node->StaticValue = successor_sum_of_weights + Suboptimality * model.H(successor_coordinate, goal);
+    if(Lookup.HasStatus(successor, OpenStatus))
+    {
+        OpenSet.decrease(successor_node);
+    }
+    else
+    {
+        // closed by a former step, and no longer queued
+        OpenSet.push(successor_node);
+        Lookup.SetStatus(successor, OpenStatus);
+    }
+}
+
+template<typename Model>
+void ARAStar::Expand(AStarNode* root_node, const Coordinate& goal, const Model& model)
+{
+    NumberOfExpandedNodes++;
+    const CellId root = Lookup.GetCellId(root_node);
+    Lookup.ClearStatus(root, OpenStatus);
+    Lookup.SetStatus(root, ClosedStatus);
+    Closed.push_back(root);
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
+    for(unsigned int directions = CurrentMap->GetNeighborMask(root); directions != 0; directions &= directions - 1)
+    {
+        const int i = std::countr_zero(directions);
+        const Coordinate& direction = eight_principle_directions[i];
+        const Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
+                                                 root_coordinate.GetColumn() + direction.GetColumn()};
+        Generate(root_node, root_coordinate, root + offsets[i], successor_coordinate, goal, model);
+    }
+}
+
+// expand nodes in order of their key until no key is below the cost of the goal. false if the deadline passed
+// first, or if the goal was not reached
+template<typename Model>
+bool ARAStar::ImprovePath(const CellId goal_cell, const Coordinate& goal, const Clock::time_point deadline,
+                          const Model& model)
+{
+    while(!OpenSet.empty())
+    {
+        const AStarNode* goal_node = Lookup.Find(goal_cell);
+        // the key of the goal is its g-value
+        if(goal_node != nullptr && goal_node->SumOfWeights <= OpenSet.top()->StaticValue)
+        {
+            return true;
+        }
+        if(IsDeadlinePassed(deadline))
+        {
+            return false;
+        }
+        AStarNode* curr = OpenSet.top();
+        MaxHeapSize = std::max(OpenSet.size(), MaxHeapSize);
+        OpenSet.pop();
+        NumberOfPopOperations++;
+        Expand(curr, goal, model);
+    }
+    return Lookup.Contains(goal_cell);
+}
+
+// bound the path of the given cost, and unless it is proven optimal, lower the factor and queue the open and
+// inconsistent nodes again under their new keys. closed nodes become expandable again. returns the bound
+template<typename Model>
+double ARAStar::Requeue(const Coordinate& goal, const double cost, const Model& model)
+{
+    std::vector<AStarNode*> frontier = OpenSet.release();
+    for(const CellId cell : Inconsistent)
+    {
+        Lookup.ClearStatus(cell, InconsistentStatus);
+        Lookup.SetStatus(cell, OpenStatus);
+        frontier.push_back(&Lookup[cell]);
+    }
+    Inconsistent.clear();
+    for(const CellId cell : Closed)
+    {
+        Lookup.ClearStatus(cell, ClosedStatus);
+    }
+    Closed.clear();
+
+    std::vector<double> heuristic_estimations(frontier.size());
+    double lower_bound = cost;
+    for(std::size_t i = 0; i < frontier.size(); i++)
+    {
+        heuristic_estimations[i] = model.H(CurrentMap->GetCoordinate(Lookup.GetCellId(frontier[i])), goal);
+        lower_bound = std::min(lower_bound, frontier[i]->SumOfWeights + heuristic_estimations[i]);
+    }
+    const double bound = (cost > 0) ? std::min(Suboptimality, cost / lower_bound) : 1;
+    if(bound <= 1)
+    {
+        return bound;
+    }
+    // the bound proven may already be below the next factor of the schedule
+    Suboptimality = std::max(std::min(Suboptimality - SuboptimalityStep, bound), 1.0);
+    for(std::size_t i = 0; i < frontier.size(); i++)
+    {
+        frontier[i]->StaticValue = frontier[i]->SumOfWeights + Suboptimality * heuristic_estimations[i];
+        OpenSet.push(frontier[i]);
+    }
+    return bound;
+}
+
+template<typename Model>
+Path ARAStar::Search(const Agent& agent, const Clock::time_point deadline, const Model& model)
+{
+    const Coordinate root_coordinate = agent.GetStartCoordinate(), goal = agent.GetGoalCoordinate();
+    const CellId root = CurrentMap->GetCellId(root_coordinate), goal_cell = CurrentMap->GetCellId(goal);
+    OpenSet.clear();
+    Inconsistent.clear();
+    Closed.clear();
+    Suboptimality = InitialSuboptimality;
+    AStarNode& root_node = Lookup[root];
+    root_node = {Suboptimality * model.H(root_coordinate, goal), 0};
+    Lookup.SetParent(root, root);
+    OpenSet.push(&root_node);
+    Lookup.SetStatus(root, OpenStatus);
+
+    Path solution;
+    while(ImprovePath(goal_cell, goal, deadline, model))
+    {
+        solution = ReconstructPath(agent);
+        const double cost = Lookup.Find(goal_cell)->SumOfWeights;
+        if(Suboptimality <= 1)
+        {
+            // a step under factor 1 expands as A* does
+            AchievedBound = 1;
+            break;
+        }
+        AchievedBound = Requeue(goal, cost, model);
+        if(AchievedBound <= 1)
+        {
+            break;
+        }
+    }
+    return solution;
+}
+
+Path ARAStar::ReconstructPath(const Agent& agent)
+{
+    CellId current = CurrentMap->GetCellId(agent.GetGoalCoordinate());
+    const CellId source = CurrentMap->GetCellId(agent.GetStartCoordinate());
+    Path solution;
+
+    while(current != source)
+    {
+        solution.emplace_back(CurrentMap->GetCoordinate(current));
+        current = Lookup.GetParent(current);
+    }
+
+    solution.push_back(agent.GetStartCoordinate());
+    std::reverse(solution.begin(), solution.end());
+
+    return solution;
+}
+
+Path ARAStar::Solve(const Agent& agent)
+{
+    return std::get<0>(SolveFullReport(agent));
+}
+
+Report ARAStar::SolveFullReport(const Agent& agent)
+{
+    return SolveFullReport(agent, Clock::now() + TimeBudget);
+}
+
+Report ARAStar::SolveFullReport(const Agent& agent, const Clock::time_point deadline)
+{
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
+    {
+        return {};
+    }
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+    AchievedBound = 0;
+    Path path;
+    if(CurrentMap->AreConnected(agent.GetStartCoordinate(), agent.GetGoalCoordinate()))
+    {
+        path = WithCostModel([&](const auto& model){ return Search(agent, deadline, model); });
+    }
+    // node slots of the whole grid, the open-set at its largest, and the cells listed as closed or inconsistent
+    PeakMemory = Lookup.GetMemoryUsage() + MaxHeapSize * sizeof(AStarNode*) +
+                 (Closed.capacity() + Inconsistent.capacity()) * sizeof(CellId);
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            path.empty() ? 0.0 : AchievedBound};
+}
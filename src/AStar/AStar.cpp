@@ -4,91 +4,104 @@
 #include "../../include/Common/Printer.h"
 #include "../../include/Common/Directions.h"
 #include <cmath>
+#include <bit> // countr_zero()
 
 const double POSITIVE_INFINITY = std::numeric_limits<double>::max();
 
-AStar::AStar(const Heuristic heuristic): ISingleAgentPathFinder(heuristic), Lookup() {}
+AStar::AStar(const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(heuristic, weight), Lookup(), OpenList(AutomaticOpenList) {}
 
-AStar::AStar(Map* map, const Heuristic heuristic): ISingleAgentPathFinder(map, heuristic), Lookup() {}
+AStar::AStar(const Map* map, const Heuristic heuristic, const Weight weight):
+    ISingleAgentPathFinder(map, heuristic, weight), Lookup(),
+    OpenList(AutomaticOpenList) {}
 
-AStar::AStar(Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight):
-        ISingleAgentPathFinder(map, heuristic, weight), Lookup() {}
+AStar::AStar(const Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight, const CostStructure costs):
+        ISingleAgentPathFinder(map, heuristic, weight, costs), Lookup(), OpenList(AutomaticOpenList) {}
 
-bool AStar::IsNodeExpanded(const Coordinate& coordinate)
+void AStar::SetOpenList(const OpenListType open_list)
 {
-    if(Lookup.find(coordinate) != Lookup.end())
-    {
-        return Lookup[coordinate].IsExpanded;
-    }
-    return false;
+    OpenList = open_list;
 }
 
-bool AStar::IsLegalSuccessor(const Coordinate& successor_coordinate)
+bool AStar::IsNodeExpanded(const CellId cell)
 {
-    return CurrentMap->IsValidCoordinate(successor_coordinate) &&
-           CurrentMap->IsPassableCoordinate(successor_coordinate) &&
-           !IsNodeExpanded(successor_coordinate);
+    return Lookup.HasStatus(cell, ClosedStatus);
 }
 
-void AStar::Generate(AStarNode* root_node, const Coordinate& successor_coordinate, const Coordinate& goal, heap_t& open_set)
+bool AStar::IsLegalSuccessor(const CellId successor)
+{
+    return !IsNodeExpanded(successor);
+}
+
+template<typename OpenSet, typename Model>
+void AStar::Generate(AStarNode* root_node, const Coordinate& root_coordinate, const CellId successor,
+                     const Coordinate& successor_coordinate, const Coordinate& goal, OpenSet& open_set, const Model& model)
 {
     // calculate static value(f) , sum of weights(g), stored value(F) for successor
-    const Coordinate& root_coordinate = root_node->MyCoordinate;
-    AStarNode& successor_node = Lookup[successor_coordinate];
-    double successor_sum_of_weights = root_node->SumOfWeights + W(root_coordinate, successor_coordinate);
-    double successor_heuristic_estimation = H(successor_coordinate, goal);
+    AStarNode* successor_node = Lookup.Find(successor);
+    double successor_sum_of_weights = root_node->SumOfWeights + model.W(root_coordinate, successor_coordinate);
+    double successor_heuristic_estimation = model.H(successor_coordinate, goal);
     double successor_static_value = successor_sum_of_weights + successor_heuristic_estimation;
 
-    if(successor_node.IsGenerated)
+    if(successor_node != nullptr)
     {
         // found shorter path to successor since heuristic estimation is fixed.
-        if(successor_node.SumOfWeights > successor_sum_of_weights)
+        if(successor_node->SumOfWeights > successor_sum_of_weights)
         {
-            successor_node.SumOfWeights = successor_sum_of_weights;
-            successor_node.StaticValue = successor_static_value;
-            successor_node.Parent = root_coordinate;
-            open_set.decrease(successor_node.HeapPointer, &successor_node);
+            successor_node->SumOfWeights = successor_sum_of_weights;
+            successor_node->StaticValue = successor_static_value;
+            Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+            open_set.decrease(successor_node);
         }
     }
     else
     {
         NumberOfGeneratedNodes++;
-        successor_node = {successor_coordinate, root_coordinate, successor_static_value, successor_sum_of_weights};
-        successor_node.IsGenerated = true;
-        successor_node.HeapPointer = open_set.emplace(&successor_node);
+        AStarNode& node = Lookup[successor];
+        node = {successor_static_value, successor_sum_of_weights};
+        Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+        open_set.push(&node);
     }
 
 }
 
-void AStar::Expand(AStarNode* root_node, const Coordinate& goal, heap_t& open_set)
+template<typename OpenSet, typename Model>
+void AStar::Expand(AStarNode* root_node, const Coordinate& goal, OpenSet& open_set, const Model& model)
 {
     NumberOfExpandedNodes++;
-    const Coordinate& root_coordinate = root_node->MyCoordinate;
-    for(const auto& direction : eight_principle_directions)
+    const CellId root = Lookup.GetCellId(root_node);
+    // the coordinate is needed by the cost model only, successors are addressed by their cell id
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
+    for(unsigned int directions = CurrentMap->GetNeighborMask(root); directions != 0; directions &= directions - 1)
     {
-        Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
-                                           root_coordinate.GetColumn() + direction.GetColumn()};
-
-        if(IsLegalSuccessor(successor_coordinate))
+        const int i = std::countr_zero(directions);
+        const CellId successor = root + offsets[i];
+        if(IsLegalSuccessor(successor))
         {
-            Generate(root_node, successor_coordinate, goal, open_set);
+            const Coordinate& direction = eight_principle_directions[i];
+            Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
+                                               root_coordinate.GetColumn() + direction.GetColumn()};
+            Generate(root_node, root_coordinate, successor, successor_coordinate, goal, open_set, model);
         }
     }
-    root_node->IsExpanded = true;
+    Lookup.SetStatus(root, ClosedStatus);
 }
 
-bool AStar::Search(const Coordinate root_coordinate, const Coordinate& goal)
+template<typename OpenSet, typename Model>
+bool AStar::Search(const Coordinate root_coordinate, const Coordinate& goal, const Model& model)
 {
     // create AStarNode for root and insert in to Lookup table
-    heap_t open_set;
-    const double root_heuristic_estimation = H(root_coordinate, goal);
-    Lookup[root_coordinate] = {root_coordinate, root_heuristic_estimation, 0};
-    AStarNode& root_node = Lookup[root_coordinate];
+    OpenSet open_set;
+    const CellId root = CurrentMap->GetCellId(root_coordinate), goal_cell = CurrentMap->GetCellId(goal);
+    const double root_heuristic_estimation = model.H(root_coordinate, goal);
+    AStarNode& root_node = Lookup[root];
+    root_node = {root_heuristic_estimation, 0};
+    Lookup.SetParent(root, root);
     //
     NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
 
     //insert pointer to root AStarNode (at Lookup) to open-set
-    root_node.HeapPointer = open_set.emplace(&root_node);
+    open_set.push(&root_node);
     while(!open_set.empty())
     {
         AStarNode* curr = open_set.top();
@@ -97,29 +110,54 @@ bool AStar::Search(const Coordinate root_coordinate, const Coordinate& goal)
         open_set.pop();
         NumberOfPopOperations++;
 
-        if(IsGoal(curr->MyCoordinate, goal))
+        if(Lookup.GetCellId(curr) == goal_cell)
         {
             return true;
         }
 
-        Expand(curr, goal, open_set);
+        Expand(curr, goal, open_set, model);
     }
     return false;
 }
 
+bool AStar::Search(const Coordinate root_coordinate, const Coordinate& goal)
+{
+    const OpenListType open_list = SelectOpenList(OpenList);
+    return WithCostModel([&](const auto& model)
+    {
+        if(TieOrder == DeepTieBreak)
+        {
+            return (open_list == FibonacciHeapOpenList) ? Search<deep_fibonacci_heap_t>(root_coordinate, goal, model) :
+                                                          Search<deep_quaternary_heap_t>(root_coordinate, goal, model);
+        }
+        switch(open_list)
+        {
+            case FibonacciHeapOpenList:
+                return Search<fibonacci_heap_t>(root_coordinate, goal, model);
+            case BucketOpenList:
+                return Search<bucket_queue_t>(root_coordinate, goal, model);
+            case IntegralBucketOpenList:
+                return Search<integral_bucket_queue_t>(root_coordinate, goal, model);
+            default:
+                return Search<quaternary_heap_t>(root_coordinate, goal, model);
+        }
+    });
+}
+
 Path AStar::ReconstructPath(const Agent& agent)
 {
-    Coordinate current = Lookup[agent.GetGoalCoordinate()].MyCoordinate;
-    const Coordinate& source = Lookup[agent.GetStartCoordinate()].MyCoordinate;
+    // cells are converted to coordinates only here, once the path is handed out
+    CellId current = CurrentMap->GetCellId(agent.GetGoalCoordinate());
+    const CellId source = CurrentMap->GetCellId(agent.GetStartCoordinate());
     Path solution;
 
     while(current != source)
     {
-        solution.emplace_back(current);
-        current = Lookup[current].Parent;
+        solution.emplace_back(CurrentMap->GetCoordinate(current));
+        current = Lookup.GetParent(current);
     }
 
-    solution.push_back(source);
+    solution.push_back(agent.GetStartCoordinate());
     std::reverse(solution.begin(), solution.end());
 
     return solution;
@@ -127,14 +165,14 @@ Path AStar::ReconstructPath(const Agent& agent)
 
 Path AStar::Solve(const Agent& agent)
 {
-    if(CurrentMap == nullptr)
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
     {
-        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nulltptr!\n");
         return {};
     }
-    Lookup.clear();
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
     const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
-    bool is_solution_found = Search(src, dst);
+    // a goal outside of the component of the start is rejected without a search
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
     if(is_solution_found)
     {
         return ReconstructPath(agent);
@@ -144,19 +182,21 @@ Path AStar::Solve(const Agent& agent)
 
 Report AStar::SolveFullReport(const Agent& agent)
 {
-    if(CurrentMap == nullptr)
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
     {
-        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nulltptr!\n");
         return {};
     }
-    Lookup.clear();
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
     NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
     const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
-    bool is_solution_found = Search(src, dst);
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
     Path path;
     if(is_solution_found)
     {
         path = ReconstructPath(agent);
     }
-    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize};
+    // node slots of the whole grid, and one open-set entry per node at the largest open-set
+    PeakMemory = Lookup.GetMemoryUsage() + MaxHeapSize * sizeof(AStarNode*);
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            path.empty() ? 0.0 : 1.0};
 }
\ No newline at end of file
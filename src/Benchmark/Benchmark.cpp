@@ -0,0 +1,266 @@
+#include "../../include/Benchmark/Benchmark.h"
+#include "../../include/Common/Map.h"
+#include <chrono>
+#include <cmath> // abs(), ceil(), isfinite()
+#include <algorithm> // sort(), max()
+#include <iomanip> // setprecision()
+
+// sums of sqrt(2) moves drift slightly with their order
+constexpr double COST_TOLERANCE = 1e-6;
+
+Benchmark::Benchmark(ISingleAgentPathFinder& solver, const Map& map, const Weight weight, const std::size_t number_of_warmups,
+                     const std::size_t number_of_repetitions):
+    Solver(solver), CurrentMap(map), CostWeight(weight),
+    // both heuristics are consistent under their weight
+    Reference(&map, (weight == OctileWeight) ? Octile : Chebyshev, weight), NumberOfWarmups(number_of_warmups),
+    NumberOfRepetitions(std::max<std::size_t>(number_of_repetitions, 1)), Queries() {}
+
+QueryRecord Benchmark::Measure(const Agent& agent)
+{
+    constexpr int PATH = 0, NEXPANDED = 2, NGENERAED = 3, NPOPED = 4, NHEAP = 5, NBOUND = 8;
+    using Clock = std::chrono::steady_clock;
+    for(std::size_t i = 0; i < NumberOfWarmups; i++)
+    {
+        Solver.SolveFullReport(agent);
+    }
+    std::vector<double> wall_times(NumberOfRepetitions);
+    Report report;
+    for(double& wall_time : wall_times)
+    {
+        const auto start = Clock::now();
+        report = Solver.SolveFullReport(agent);
+        wall_time = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+    std::sort(wall_times.begin(), wall_times.end());
+
+    QueryRecord record;
+    record.Task = agent;
+    record.WallTime = wall_times[wall_times.size() / 2];
+    const Path& path = get<PATH>(report);
+    for(std::size_t i = 1; i < path.size(); i++)
+    {
+        const bool is_diagonal = path[i].GetRow() != path[i - 1].GetRow() && path[i].GetColumn() != path[i - 1].GetColumn();
+        record.OctileLength += is_diagonal ? SQRT2 : 1;
+    }
+    record.Cost = GetCost(path);
+    record.NumberOfExpandedNodes = get<NEXPANDED>(report);
+    record.NumberOfGeneratedNodes = get<NGENERAED>(report);
+    record.NumberOfPopOperations = get<NPOPED>(report);
+    record.MaxHeapSize = get<NHEAP>(report);
+    record.Bound = get<NBOUND>(report);
+    record.OptimalCost = GetCost(Reference.Solve(agent));
+    record.Status = path.empty() ? Unsolved : Validate(record);
+    return record;
+}
+
+double Benchmark::GetCost(const Path& path) const
+{
+    double cost = 0;
+    for(std::size_t i = 1; i < path.size(); i++)
+    {
+        const bool is_diagonal = path[i].GetRow() != path[i - 1].GetRow() && path[i].GetColumn() != path[i - 1].GetColumn();
+        cost += (is_diagonal && CostWeight == OctileWeight) ? SQRT2 : 1;
+    }
+    return cost;
+}
+
+Validation Benchmark::Validate(const QueryRecord& record) const
+{
+    if(record.OptimalCost == 0 && record.Task.GetStartCoordinate() != record.Task.GetGoalCoordinate())
+    {
+        return Unchecked;
+    }
+    const double tolerance = COST_TOLERANCE * std::max(1.0, record.OptimalCost);
+    if(std::abs(record.Cost - record.OptimalCost) <= tolerance)
+    {
+        return Optimal;
+    }
+    return (record.Cost < record.OptimalCost) ? Shorter : Longer;
+}
+
+void Benchmark::Run(const std::vector<std::vector<Agent>>& agents)
+{
+    Queries.clear();
+    Solver.SetMap(&CurrentMap);
+    for(std::size_t bucket = 0; bucket < agents.size(); bucket++)
+    {
+        for(std::size_t index = 0; index < agents[bucket].size(); index++)
+        {
+            QueryRecord record = Measure(agents[bucket][index]);
+            record.Bucket = bucket;
+            record.Index = index;
+            Queries.push_back(std::move(record));
+        }
+    }
+}
+
+const std::vector<QueryRecord>& Benchmark::GetQueries(void) const
+{
+    return Queries;
+}
+
+Percentiles Benchmark::Summarize(std::vector<double>& values)
+{
+    Percentiles percentiles;
+    if(values.empty())
+    {
+        return percentiles;
+    }
+    std::sort(values.begin(), values.end());
+    // nearest rank: the smallest value such that at least p percent of the values are not greater
+    auto rank = [&values](const double p)
+    {
+        const std::size_t index = static_cast<std::size_t>(std::ceil(p / 100 * values.size()));
+        return values[std::max<std::size_t>(index, 1) - 1];
+    };
+    for(const double value : values)
+    {
+        percentiles.Mean += value;
+    }
+    percentiles.Mean /= values.size();
+    percentiles.P50 = rank(50);
+    percentiles.P95 = rank(95);
+    percentiles.P99 = rank(99);
+    return percentiles;
+}
+
+BucketSummary Benchmark::Summarize(std::string bucket, const std::vector<const QueryRecord*>& records)
+{
+    BucketSummary summary;
+    summary.Bucket = std::move(bucket);
+    summary.NumberOfQueries = records.size();
+    std::vector<double> wall_times, expanded_nodes, generated_nodes, pop_operations;
+    for(const QueryRecord* record : records)
+    {
+        summary.NumberOfSolved += record->Status != Unsolved;
+        summary.NumberOfOptimal += record->Status == Optimal;
+        summary.NumberOfShorter += record->Status == Shorter;
+        summary.NumberOfLonger += record->Status == Longer;
+        summary.NumberOfUnsolved += record->Status == Unsolved;
+        summary.MaxHeapSize = std::max(summary.MaxHeapSize, record->MaxHeapSize);
+        wall_times.push_back(record->WallTime);
+        expanded_nodes.push_back(record->NumberOfExpandedNodes);
+        generated_nodes.push_back(record->NumberOfGeneratedNodes);
+        pop_operations.push_back(record->NumberOfPopOperations);
+    }
+    summary.WallTime = Summarize(wall_times);
+    summary.ExpandedNodes = Summarize(expanded_nodes);
+    summary.GeneratedNodes = Summarize(generated_nodes);
+    summary.PopOperations = Summarize(pop_operations);
+    return summary;
+}
+
+std::vector<BucketSummary> Benchmark::GetBucketSummaries(void) const
+{
+    std::vector<BucketSummary> summaries;
+    std::vector<const QueryRecord*> bucket_records, all_records;
+    for(std::size_t i = 0; i < Queries.size(); i++)
+    {
+        bucket_records.push_back(&Queries[i]);
+        all_records.push_back(&Queries[i]);
+        // queries are stored by bucket, a bucket ends where the next one begins
+        if(i + 1 == Queries.size() || Queries[i + 1].Bucket != Queries[i].Bucket)
+        {
+            summaries.push_back(Summarize(std::to_string(Queries[i].Bucket), bucket_records));
+            bucket_records.clear();
+        }
+    }
+    summaries.push_back(Summarize("all", all_records));
+    return summaries;
+}
+
+static const char* GetValidationName(const Validation status)
+{
+    constexpr const char* NAMES[] = {"unchecked", "optimal", "shorter", "longer", "unsolved"};
+    return NAMES[status];
+}
+
+void Benchmark::WriteQueriesCsv(std::ostream& out) const
+{
+    out << std::setprecision(10);
+    out << "bucket,index,start_row,start_column,goal_row,goal_column,optimal_length,wall_time_ms,cost,optimal_cost,"
+           "octile_length,expanded,generated,popped,max_heap_size,bound,validation\n";
+    for(const QueryRecord& record : Queries)
+    {
+        const Coordinate start = record.Task.GetStartCoordinate(), goal = record.Task.GetGoalCoordinate();
+        out << record.Bucket << ',' << record.Index << ',' << start.GetRow() << ',' << start.GetColumn() << ','
+            << goal.GetRow() << ',' << goal.GetColumn() << ',' << record.Task.GetOptimalLength() << ',' << record.WallTime << ','
+            << record.Cost << ',' << record.OptimalCost << ',' << record.OctileLength << ',' << record.NumberOfExpandedNodes << ','
+            << record.NumberOfGeneratedNodes << ',' << record.NumberOfPopOperations << ',' << record.MaxHeapSize << ','
+            << record.Bound << ',' << GetValidationName(record.Status) << '\n';
+    }
+}
+
+void Benchmark::WriteQueriesJson(std::ostream& out) const
+{
+    out << std::setprecision(10) << "[\n";
+    for(std::size_t i = 0; i < Queries.size(); i++)
+    {
+        const QueryRecord& record = Queries[i];
+        const Coordinate start = record.Task.GetStartCoordinate(), goal = record.Task.GetGoalCoordinate();
+        out << "  {\"bucket\": " << record.Bucket << ", \"index\": " << record.Index
+            << ", \"start\": [" << start.GetRow() << ", " << start.GetColumn() << "], \"goal\": [" << goal.GetRow() << ", "
+            << goal.GetColumn() << "], \"optimal_length\": " << record.Task.GetOptimalLength()
+            << ", \"wall_time_ms\": " << record.WallTime << ", \"cost\": " << record.Cost
+            << ", \"optimal_cost\": " << record.OptimalCost
+            << ", \"octile_length\": " << record.OctileLength << ", \"expanded\": " << record.NumberOfExpandedNodes
+            << ", \"generated\": " << record.NumberOfGeneratedNodes << ", \"popped\": " << record.NumberOfPopOperations
+            << ", \"max_heap_size\": " << record.MaxHeapSize << ", \"bound\": ";
+        // JSON has no infinity
+        std::isfinite(record.Bound) ? out << record.Bound : out << "null";
+        out << ", \"validation\": \"" << GetValidationName(record.Status) << "\"}"
+            << ((i + 1 < Queries.size()) ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
+
+void Benchmark::WriteSummariesCsv(std::ostream& out) const
+{
+    out << std::setprecision(10);
+    out << "bucket,queries,solved,optimal,shorter,longer,unsolved,max_heap_size";
+    for(const char* metric : {"wall_time_ms", "expanded", "generated", "popped"})
+    {
+        for(const char* statistic : {"mean", "p50", "p95", "p99"})
+        {
+            out << ',' << metric << '_' << statistic;
+        }
+    }
+    out << '\n';
+    for(const BucketSummary& summary : GetBucketSummaries())
+    {
+        out << summary.Bucket << ',' << summary.NumberOfQueries << ',' << summary.NumberOfSolved << ','
+            << summary.NumberOfOptimal << ',' << summary.NumberOfShorter << ',' << summary.NumberOfLonger << ','
+            << summary.NumberOfUnsolved << ',' << summary.MaxHeapSize;
+        for(const Percentiles& p : {summary.WallTime, summary.ExpandedNodes, summary.GeneratedNodes, summary.PopOperations})
+        {
+            out << ',' << p.Mean << ',' << p.P50 << ',' << p.P95 << ',' << p.P99;
+        }
+        out << '\n';
+    }
+}
+
+static void WritePercentilesJson(std::ostream& out, const char* name, const Percentiles& p)
+{
+    out << ", \"" << name << "\": {\"mean\": " << p.Mean << ", \"p50\": " << p.P50 << ", \"p95\": " << p.P95
+        << ", \"p99\": " << p.P99 << '}';
+}
+
+void Benchmark::WriteSummariesJson(std::ostream& out) const
+{
+    const std::vector<BucketSummary> summaries = GetBucketSummaries();
+    out << std::setprecision(10) << "[\n";
+    for(std::size_t i = 0; i < summaries.size(); i++)
+    {
+        const BucketSummary& summary = summaries[i];
+        out << "  {\"bucket\": \"" << summary.Bucket << "\", \"queries\": " << summary.NumberOfQueries
+            << ", \"solved\": " << summary.NumberOfSolved << ", \"optimal\": " << summary.NumberOfOptimal
+            << ", \"shorter\": " << summary.NumberOfShorter << ", \"longer\": " << summary.NumberOfLonger
+            << ", \"unsolved\": " << summary.NumberOfUnsolved << ", \"max_heap_size\": " << summary.MaxHeapSize;
+        WritePercentilesJson(out, "wall_time_ms", summary.WallTime);
+        WritePercentilesJson(out, "expanded", summary.ExpandedNodes);
+        WritePercentilesJson(out, "generated", summary.GeneratedNodes);
+        WritePercentilesJson(out, "popped", summary.PopOperations);
+        out << '}' << ((i + 1 < summaries.size()) ? ",\n" : "\n");
+    }
+    out << "]\n";
+}
@@ -0,0 +1,363 @@
+#include "../../include/BoundedAStar/BoundedAStar.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Agent.h"
+#include "../../include/Common/Printer.h"
+#include "../../include/Common/Directions.h"
+#include <cmath>
+#include <cstdlib> // abs()
+#include <bit> // countr_zero()
+
+// EES, the corrected number of moves d / (1 - error) is kept finite
+constexpr double MAX_DISTANCE_ERROR = 0.99;
+
+BoundedAStar::BoundedAStar(const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(heuristic, weight),
+    Lookup(), Mode(WeightedAStarSearch), Suboptimality(1.05), AchievedBound(0), SumOfHeuristicErrors(0),
+    SumOfDistanceErrors(0), NumberOfErrorSamples(0) {}
+
+BoundedAStar::BoundedAStar(const Map* map, const Heuristic heuristic, const Weight weight):
+    ISingleAgentPathFinder(map, heuristic, weight), Lookup(), Mode(WeightedAStarSearch), Suboptimality(1.05),
+    AchievedBound(0), SumOfHeuristicErrors(0), SumOfDistanceErrors(0), NumberOfErrorSamples(0) {}
+
+BoundedAStar::BoundedAStar(const Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight,
+                           const CostStructure costs):
+    ISingleAgentPathFinder(map, heuristic, weight, costs), Lookup(), Mode(WeightedAStarSearch), Suboptimality(1.05),
+    AchievedBound(0), SumOfHeuristicErrors(0), SumOfDistanceErrors(0), NumberOfErrorSamples(0) {}
+
+void BoundedAStar::SetMode(const SuboptimalSearch mode)
+{
+    Mode = mode;
+}
+
+void BoundedAStar::SetSuboptimality(const double suboptimality)
+{
+    Suboptimality = std::max(suboptimality, 1.0);
+}
+
+// least number of moves to the goal over an 8-connected grid, regardless of obstacles
+int BoundedAStar::GetNumberOfMoves(const Coordinate& from, const Coordinate& to) const
+{
+    return std::max(std::abs(to.GetRow() - from.GetRow()), std::abs(to.GetColumn() - from.GetColumn()));
+}
+
+// set the estimate and the distance of a node from its g-value, its heuristic estimation h and its number of moves
+void BoundedAStar::Evaluate(BoundedAStarNode& node, const double heuristic_estimation, const int number_of_moves) const
+{
+    switch(Mode)
+    {
+        case WeightedAStarSearch:
+            node.Estimate = node.SumOfWeights + Suboptimality * heuristic_estimation;
+            node.Distance = number_of_moves;
+            break;
+        case FocalSearch:
+            node.Estimate = node.StaticValue;
+            node.Distance = number_of_moves;
+            break;
+        case ExplicitEstimationSearch:
+        {
+            // mean one-step errors, h is admissible and the number of moves exact at best, so neither shrinks
+            const double samples = std::max(NumberOfErrorSamples, 1u);
+            const double heuristic_error = std::max(SumOfHeuristicErrors / samples, 0.0);
+            const double distance_error = std::clamp(SumOfDistanceErrors / samples, 0.0, MAX_DISTANCE_ERROR);
+            node.Distance = number_of_moves / (1 - distance_error);
+            node.Estimate = node.StaticValue + heuristic_error * node.Distance;
+            break;
+        }
+    }
+}
+
+void BoundedAStar::Insert(BoundedAStarNode* node, OpenSet& open_set)
+{
+    open_set.Cleanup.push(node);
+    if(Mode == ExplicitEstimationSearch)
+    {
+        open_set.Estimates.push(node);
+    }
+    // the node joins the focal list, if it qualifies, at the next selection
+    node->IsFocal = false;
+    open_set.Waiting.push(node);
+}
+
+// restore the order of the open lists after a queued node was reached by a cheaper path
+void BoundedAStar::Improve(BoundedAStarNode* node, OpenSet& open_set)
+{
+    open_set.Cleanup.decrease(node);
+    if(Mode == ExplicitEstimationSearch)
+    {
+        // corrections of h may have changed since the node was evaluated, the estimate moves either way
+        open_set.Estimates.update(node);
+    }
+    if(node->IsFocal)
+    {
+        open_set.Focal.update(node);
+    }
+    else
+    {
+        open_set.Waiting.update(node);
+    }
+}
+
+void BoundedAStar::Remove(BoundedAStarNode* node, OpenSet& open_set)
+{
+    open_set.Cleanup.erase(node);
+    if(Mode == ExplicitEstimationSearch)
+    {
+        open_set.Estimates.erase(node);
+    }
+    if(node->IsFocal)
+    {
+        open_set.Focal.erase(node);
+    }
+    else
+    {
+        open_set.Waiting.erase(node);
+    }
+}
+
+// move the inconsistent node of least f-value back to the open lists
+void BoundedAStar::Reopen(OpenSet& open_set)
+{
+    BoundedAStarNode* node = open_set.Inconsistent.top();
+    open_set.Inconsistent.pop();
+    node->IsInconsistent = false;
+    Lookup.ClearStatus(Lookup.GetCellId(node), ClosedStatus);
+    Insert(node, open_set);
+}
+
+// least f-value of the open and inconsistent nodes, infinity if there are none. until the goal is expanded, some
+// node of a cheapest path is either open or inconsistent with its cheapest g-value, so under an admissible
+// heuristic the cheapest cost is no less
+double BoundedAStar::GetLowerBound(OpenSet& open_set) const
+{
+    double lower_bound = std::numeric_limits<double>::infinity();
+    for(const cleanup_heap_t* list : {&open_set.Cleanup, &open_set.Inconsistent})
+    {
+        if(!list->empty())
+        {
+            lower_bound = std::min(lower_bound, list->top()->StaticValue);
+        }
+    }
+    return lower_bound;
+}
+
+// move the waiting nodes whose estimate is within w times the least one into the focal list. the least estimate
+// only grows under a consistent heuristic, nodes which fall behind it otherwise stay, and are checked on selection
+void BoundedAStar::RefreshFocal(OpenSet& open_set)
+{
+    const double least_estimate = (Mode == ExplicitEstimationSearch) ? open_set.Estimates.top()->Estimate :
+                                  GetLowerBound(open_set);
+    const double threshold = Suboptimality * least_estimate;
+    while(!open_set.Waiting.empty() && open_set.Waiting.top()->Estimate <= threshold)
+    {
+        BoundedAStarNode* node = open_set.Waiting.top();
+        open_set.Waiting.pop();
+        node->IsFocal = true;
+        open_set.Focal.push(node);
+    }
+}
+
+// the open-set must not be empty. weighted A* selects by estimate alone, which bounds the cost of the path found by
+// w under a consistent heuristic. otherwise every selected node has an f-value within w times the lower bound
+BoundedAStarNode* BoundedAStar::Select(OpenSet& open_set)
+{
+    if(Mode == WeightedAStarSearch)
+    {
+        return open_set.Waiting.top();
+    }
+    // no open node may be selected while an inconsistent one holds the lower bound below 1/w of them
+    while(!open_set.Inconsistent.empty() &&
+          Suboptimality * open_set.Inconsistent.top()->StaticValue < open_set.Cleanup.top()->StaticValue)
+    {
+        Reopen(open_set);
+    }
+    RefreshFocal(open_set);
+    BoundedAStarNode* best_f = open_set.Cleanup.top();
+    const double threshold = Suboptimality * GetLowerBound(open_set);
+    BoundedAStarNode* best_distance = open_set.Focal.empty() ? nullptr : open_set.Focal.top();
+    if(Mode == FocalSearch)
+    {
+        return (best_distance != nullptr && best_distance->StaticValue <= threshold) ? best_distance : best_f;
+    }
+    // corrected f-values are no less than f-values, hence within the threshold they bound f as well
+    if(best_distance != nullptr && best_distance->Estimate <= threshold)
+    {
+        return best_distance;
+    }
+    BoundedAStarNode* best_estimate = open_set.Estimates.top();
+    return (best_estimate->Estimate <= threshold) ? best_estimate : best_f;
+}
+
+template<typename Model>
+void BoundedAStar::Expand(BoundedAStarNode* root_node, const Coordinate& goal, OpenSet& open_set, const Model& model)
+{
+    NumberOfExpandedNodes++;
+    const CellId root = Lookup.GetCellId(root_node);
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
+    // EES only, f-value and number of moves of the best successor
+    double best_static_value = std::numeric_limits<double>::infinity();
+    int best_number_of_moves = 0;
+    for(unsigned int directions = CurrentMap->GetNeighborMask(root); directions != 0; directions &= directions - 1)
+    {
+        const int i = std::countr_zero(directions);
+        const CellId successor = root + offsets[i];
+        const Coordinate& direction = eight_principle_directions[i];
+        const Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
+                                                 root_coordinate.GetColumn() + direction.GetColumn()};
+        const double successor_sum_of_weights = root_node->SumOfWeights + model.W(root_coordinate, successor_coordinate);
+        const int successor_number_of_moves = GetNumberOfMoves(successor_coordinate, goal);
+        BoundedAStarNode* successor_node = Lookup.Find(successor);
+        double successor_heuristic_estimation;
+        if(successor_node == nullptr)
+        {
+            NumberOfGeneratedNodes++;
+            successor_heuristic_estimation = model.H(successor_coordinate, goal);
+            successor_node = &Lookup[successor];
+            successor_node->SumOfWeights = successor_sum_of_weights;
+            successor_node->StaticValue = successor_sum_of_weights + successor_heuristic_estimation;
+            Evaluate(*successor_node, successor_heuristic_estimation, successor_number_of_moves);
+            Lookup.SetParent(successor, root);
+            Insert(successor_node, open_set);
+        }
+        else
+        {
+            // heuristic estimation is fixed, hence recovered from the values of the node
+            successor_heuristic_estimation = successor_node->StaticValue - successor_node->SumOfWeights;
+            if(successor_node->SumOfWeights > successor_sum_of_weights)
+            {
+                successor_node->SumOfWeights = successor_sum_of_weights;
+                successor_node->StaticValue = successor_sum_of_weights + successor_heuristic_estimation;
+                Evaluate(*successor_node, successor_heuristic_estimation, successor_number_of_moves);
+                Lookup.SetParent(successor, root);
+                if(successor_node->IsInconsistent)
+                {
+                    open_set.Inconsistent.decrease(successor_node);
+                }
+                else if(Lookup.HasStatus(successor, ClosedStatus))
+                {
+                    successor_node->IsInconsistent = true;
+                    open_set.Inconsistent.push(successor_node);
+                }
+                else
+                {
+                    Improve(successor_node, open_set);
+                }
+            }
+        }
+        const double successor_static_value = successor_sum_of_weights + successor_heuristic_estimation;
+        if(successor_static_value < best_static_value ||
+           (successor_static_value == best_static_value && successor_number_of_moves < best_number_of_moves))
+        {
+            best_static_value = successor_static_value;
+            best_number_of_moves = successor_number_of_moves;
+        }
+    }
+    Lookup.SetStatus(root, ClosedStatus);
+
+    if(Mode == ExplicitEstimationSearch && best_static_value != std::numeric_limits<double>::infinity())
+    {
+        // one-step errors: the growth of f, and the moves left beyond the one taken, along the best successor
+        SumOfHeuristicErrors += best_static_value - root_node->StaticValue;
+        SumOfDistanceErrors += 1 + best_number_of_moves - GetNumberOfMoves(root_coordinate, goal);
+        NumberOfErrorSamples++;
+    }
+}
+
+template<typename Model>
+bool BoundedAStar::Search(const Coordinate root_coordinate, const Coordinate& goal, const Model& model)
+{
+    OpenSet open_set;
+    const CellId root = CurrentMap->GetCellId(root_coordinate), goal_cell = CurrentMap->GetCellId(goal);
+    SumOfHeuristicErrors = SumOfDistanceErrors = 0;
+    NumberOfErrorSamples = 0;
+    const double root_heuristic_estimation = model.H(root_coordinate, goal);
+    BoundedAStarNode& root_node = Lookup[root];
+    root_node.SumOfWeights = 0;
+    root_node.StaticValue = root_heuristic_estimation;
+    Evaluate(root_node, root_heuristic_estimation, GetNumberOfMoves(root_coordinate, goal));
+    Lookup.SetParent(root, root);
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+
+    Insert(&root_node, open_set);
+    while(!open_set.Cleanup.empty())
+    {
+        MaxHeapSize = std::max(open_set.Cleanup.size(), MaxHeapSize);
+        BoundedAStarNode* curr = Select(open_set);
+        Remove(curr, open_set);
+        NumberOfPopOperations++;
+
+        if(Lookup.GetCellId(curr) == goal_cell)
+        {
+            // the goal competes for the least f-value with its own cost, its h-value being 0. every mode ensures w
+            // already, which is tighter when inconsistent nodes were reached early by barely cheaper paths
+            const double cost = curr->SumOfWeights;
+            const double lower_bound = std::min(cost, GetLowerBound(open_set));
+            AchievedBound = (cost > 0) ? std::min(cost / lower_bound, Suboptimality) : 1;
+            return true;
+        }
+
+        Expand(curr, goal, open_set, model);
+    }
+    return false;
+}
+
+bool BoundedAStar::Search(const Coordinate root_coordinate, const Coordinate& goal)
+{
+    return WithCostModel([&](const auto& model){ return Search(root_coordinate, goal, model); });
+}
+
+Path BoundedAStar::ReconstructPath(const Agent& agent)
+{
+    CellId current = CurrentMap->GetCellId(agent.GetGoalCoordinate());
+    const CellId source = CurrentMap->GetCellId(agent.GetStartCoordinate());
+    Path solution;
+
+    while(current != source)
+    {
+        solution.emplace_back(CurrentMap->GetCoordinate(current));
+        current = Lookup.GetParent(current);
+    }
+
+    solution.push_back(agent.GetStartCoordinate());
+    std::reverse(solution.begin(), solution.end());
+
+    return solution;
+}
+
+Path BoundedAStar::Solve(const Agent& agent)
+{
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
+    {
+        return {};
+    }
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+    const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
+    if(is_solution_found)
+    {
+        return ReconstructPath(agent);
+    }
+    return {};
+}
+
+Report BoundedAStar::SolveFullReport(const Agent& agent)
+{
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
+    {
+        return {};
+    }
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+    AchievedBound = 0;
+    const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
+    Path path;
+    if(is_solution_found)
+    {
+        path = ReconstructPath(agent);
+    }
+    // every open node is queued in the cleanup list, in the focal or waiting list, and for EES in the estimate list
+    const std::size_t number_of_lists = (Mode == ExplicitEstimationSearch) ? 3 : 2;
+    PeakMemory = Lookup.GetMemoryUsage() + MaxHeapSize * number_of_lists * sizeof(BoundedAStarNode*);
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            path.empty() ? 0.0 : AchievedBound};
+}
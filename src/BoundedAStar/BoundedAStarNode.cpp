@@ -0,0 +1,34 @@
+#include "../../include/BoundedAStar/BoundedAStarNode.h"
+#include <cmath>
+#include <type_traits>
+
+// nodes are stored per map cell and copied as plain memory
+static_assert(std::is_trivially_copyable_v<BoundedAStarNode> && sizeof(BoundedAStarNode) <= 48);
+
+const double POSITIVE_INFINITY = std::numeric_limits<double>::max();
+
+BoundedAStarNode::BoundedAStarNode(): StaticValue(POSITIVE_INFINITY), SumOfWeights(0), Estimate(POSITIVE_INFINITY),
+    Distance(0), HeapIndex(0), SelectionIndex(0), EstimateIndex(0), IsFocal(false),
+    IsInconsistent(false) {}
+
+std::ostream& operator << (std::ostream& out, const BoundedAStarNode& node)
+{
+    return out << "<f=" << node.StaticValue << ", g=" << node.SumOfWeights << ", estimate=" << node.Estimate
+               << ", d=" << node.Distance << '>';
+}
+
+bool CleanupComparator::operator()(const BoundedAStarNode* n1, const BoundedAStarNode* n2) const
+{
+    return (n1->StaticValue == n2->StaticValue) ? (n1->SumOfWeights < n2->SumOfWeights) :
+           (n1->StaticValue > n2->StaticValue);
+}
+
+bool EstimateComparator::operator()(const BoundedAStarNode* n1, const BoundedAStarNode* n2) const
+{
+    return (n1->Estimate == n2->Estimate) ? (n1->SumOfWeights < n2->SumOfWeights) : (n1->Estimate > n2->Estimate);
+}
+
+bool DistanceComparator::operator()(const BoundedAStarNode* n1, const BoundedAStarNode* n2) const
+{
+    return (n1->Distance == n2->Distance) ? (n1->Estimate > n2->Estimate) : (n1->Distance > n2->Distance);
+}
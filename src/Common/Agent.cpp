@@ -1,12 +1,14 @@
 #include "../../include/Common/Agent.h"
 
-Agent::Agent() : Start(), Goal() {}
-Agent::Agent(int const start_row, int const start_column, int const goal_row, int const goal_column) : Start(start_row, start_column), Goal(goal_row, goal_column) {}
-Agent::Agent(Agent const& other): Start(other.Start), Goal(other.Goal) {}
-Agent::Agent(Coordinate const& start, Coordinate const& goal): Start(start), Goal(goal) {}
+Agent::Agent() : Start(), Goal(), OptimalLength(0) {}
+Agent::Agent(int const start_row, int const start_column, int const goal_row, int const goal_column, double const optimal_length) :
+        Start(start_row, start_column), Goal(goal_row, goal_column), OptimalLength(optimal_length) {}
+Agent::Agent(Agent const& other): Start(other.Start), Goal(other.Goal), OptimalLength(other.OptimalLength) {}
+Agent::Agent(Coordinate const& start, Coordinate const& goal): Start(start), Goal(goal), OptimalLength(0) {}
 Agent::Agent(Coordinate&& start, Coordinate&& goal):
-        Start(std::forward<Coordinate>(start)), Goal(std::forward<Coordinate>(goal)) {}
-Agent::Agent(Agent&& other) noexcept: Start(std::forward<Coordinate>(other.Start)), Goal(std::forward<Coordinate>(other.Goal)) {}
+        Start(std::forward<Coordinate>(start)), Goal(std::forward<Coordinate>(goal)), OptimalLength(0) {}
+Agent::Agent(Agent&& other) noexcept: Start(std::forward<Coordinate>(other.Start)), Goal(std::forward<Coordinate>(other.Goal)),
+        OptimalLength(other.OptimalLength) {}
 
 Agent& Agent::operator=(Agent const& other)
 {
@@ -14,6 +16,7 @@ Agent& Agent::operator=(Agent const& other)
     {
         Start = other.Start;
         Goal = other.Goal;
+        OptimalLength = other.OptimalLength;
     }
     return *this;
 }
@@ -23,9 +26,11 @@ Agent& Agent::operator=(Agent &&other) noexcept
     {
         Start = std::forward<Coordinate>(other.Start);
         Goal = std::forward<Coordinate>(other.Goal);
+        OptimalLength = other.OptimalLength;
     }
     return *this;
 }
 
 Coordinate Agent::GetStartCoordinate() const {return Start;}
-Coordinate Agent::GetGoalCoordinate() const {return Goal;}
\ No newline at end of file
+Coordinate Agent::GetGoalCoordinate() const {return Goal;}
+double Agent::GetOptimalLength() const {return OptimalLength;}
\ No newline at end of file
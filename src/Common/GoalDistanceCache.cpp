@@ -0,0 +1,159 @@
+#include "../../include/Common/GoalDistanceCache.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Directions.h" // eight_principle_directions
+#include "../../include/Common/Printer.h"
+#include <bit> // countr_zero()
+#include <cmath> // nextafter()
+#include <queue> // priority_queue
+#include <limits>
+
+GoalDistanceCache::GoalDistanceCache(const Map* map, const Weight weight, const std::size_t capacity_in_megabytes):
+    CurrentMap(map), MapVersion(map == nullptr ? 0 : map->GetVersion()), MoveWeight(weight),
+    Capacity(capacity_in_megabytes << 20), Size(0), Entries(), Index(), Mutex(), NumberOfHits(0), NumberOfMisses(0) {}
+
+inline std::size_t GoalDistanceCache::CellIndex(const Coordinate& coordinate) const
+{
+    return static_cast<std::size_t>(coordinate.GetRow()) * CurrentMap->GetNumberOfColumns() + coordinate.GetColumn();
+}
+
+std::shared_ptr<const GoalDistanceCache::Table> GoalDistanceCache::Sweep(const Coordinate& goal) const
+{
+    // moves are reversible and weights symmetric, hence a forward Dijkstra from goal yields the cost to reach it
+    const std::size_t number_of_cells = static_cast<std::size_t>(CurrentMap->GetNumberOfRows()) * CurrentMap->GetNumberOfColumns();
+    constexpr double POSITIVE_INFINITY = std::numeric_limits<double>::max();
+    std::vector<double> distances(number_of_cells, POSITIVE_INFINITY);
+    using Entry = std::pair<double, Coordinate>; // distance, cell
+    auto is_farther = [](const Entry& e1, const Entry& e2){ return e1.first > e2.first; };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(is_farther)> open_set(is_farther);
+    const double diagonal_move_cost = (MoveWeight == OctileWeight) ? SQRT2 : 1;
+    constexpr std::size_t FIRST_DIAGONAL_DIRECTION = 4; // index of the first diagonal in eight_principle_directions
+
+    auto table = std::make_shared<Table>(number_of_cells, 0.0f);
+    if(!CurrentMap->IsValidCoordinate(goal) || !CurrentMap->IsPassableCoordinate(goal))
+    {
+        return table; // no cell reaches the goal
+    }
+    distances[CellIndex(goal)] = 0;
+    open_set.emplace(0, goal);
+    while(!open_set.empty())
+    {
+        const auto [distance, coordinate] = open_set.top();
+        open_set.pop();
+        if(distance > distances[CellIndex(coordinate)])
+        {
+            continue; // outdated entry
+        }
+        for(unsigned int directions = CurrentMap->GetNeighborMask(coordinate); directions != 0; directions &= directions - 1)
+        {
+            const std::size_t direction_index = std::countr_zero(directions);
+            const Coordinate& direction = eight_principle_directions[direction_index];
+            const Coordinate neighbor = {coordinate.GetRow() + direction.GetRow(), coordinate.GetColumn() + direction.GetColumn()};
+            const double neighbor_distance = distance + ((direction_index < FIRST_DIAGONAL_DIRECTION) ? 1 : diagonal_move_cost);
+            double& stored_distance = distances[CellIndex(neighbor)];
+            if(neighbor_distance < stored_distance)
+            {
+                stored_distance = neighbor_distance;
+                open_set.emplace(neighbor_distance, neighbor);
+            }
+        }
+    }
+
+    for(std::size_t cell = 0; cell < number_of_cells; cell++)
+    {
+        if(distances[cell] != POSITIVE_INFINITY)
+        {
+            // round towards zero, so the single precision estimation never exceeds the exact cost
+            float distance = static_cast<float>(distances[cell]);
+            (*table)[cell] = (distance > distances[cell]) ? std::nextafter(distance, 0.0f) : distance;
+        }
+    }
+    return table;
+}
+
+std::shared_ptr<const GoalDistanceCache::Table> GoalDistanceCache::Find(const Coordinate& goal)
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        if(MapVersion != CurrentMap->GetVersion())
+        {
+            Entries.clear();
+            Index.clear();
+            Size = 0;
+            MapVersion = CurrentMap->GetVersion();
+        }
+        auto entry = Index.find(goal);
+        if(entry != Index.end())
+        {
+            NumberOfHits++;
+            Entries.splice(Entries.begin(), Entries, entry->second);
+            return entry->second->Distances;
+        }
+        NumberOfMisses++;
+    }
+
+    // the sweep runs unlocked, a concurrent miss on the same goal may compute it twice
+    std::shared_ptr<const Table> distances = Sweep(goal);
+    const std::size_t table_size = distances->size() * sizeof(float);
+
+    std::lock_guard<std::mutex> lock(Mutex);
+    if(Index.find(goal) != Index.end())
+    {
+        return distances;
+    }
+    // evict least recently used tables, solvers which still hold one keep it alive until they are done
+    while(!Entries.empty() && Size + table_size > Capacity)
+    {
+        Size -= Entries.back().Distances->size() * sizeof(float);
+        Index.erase(Entries.back().Goal);
+        Entries.pop_back();
+    }
+    Entries.push_front({goal, distances});
+    Index[goal] = Entries.begin();
+    Size += table_size;
+    return distances;
+}
+
+HeuristicFunction GoalDistanceCache::GetHeuristic(const Weight weight)
+{
+    if(weight != MoveWeight)
+    {
+        DisplayMessage(Red, __PRETTY_FUNCTION__, ": the cache holds costs of another weight than the solver's\n");
+        return {};
+    }
+    return [this, goal = Coordinate(-1, -1), version = std::uint64_t(0), distances = std::shared_ptr<const Table>()]
+           (const Coordinate& src, const Coordinate& dst) mutable -> double
+    {
+        if(distances == nullptr || dst != goal || version != CurrentMap->GetVersion())
+        {
+            distances = Find(dst);
+            goal = dst;
+            version = CurrentMap->GetVersion();
+        }
+        return (*distances)[CellIndex(src)];
+    };
+}
+
+void GoalDistanceCache::Clear(void)
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    Entries.clear();
+    Index.clear();
+    Size = 0;
+}
+
+const Map* GoalDistanceCache::GetMap(void) const
+{
+    return CurrentMap;
+}
+
+unsigned long GoalDistanceCache::GetNumberOfHits(void) const
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    return NumberOfHits;
+}
+
+unsigned long GoalDistanceCache::GetNumberOfMisses(void) const
+{
+    std::lock_guard<std::mutex> lock(Mutex);
+    return NumberOfMisses;
+}
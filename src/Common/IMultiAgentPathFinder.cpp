@@ -0,0 +1,58 @@
+#include "../../include/Common/IMultiAgentPathFinder.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Printer.h"
+#include <unordered_set>
+
+IMultiAgentPathFinder::IMultiAgentPathFinder(): CurrentMap(nullptr), NumberOfExpandedNodes(0), NumberOfLowLevelSearches(0),
+    NumberOfLowLevelExpandedNodes(0) {}
+
+IMultiAgentPathFinder::IMultiAgentPathFinder(const Map* map): CurrentMap(map), NumberOfExpandedNodes(0),
+    NumberOfLowLevelSearches(0), NumberOfLowLevelExpandedNodes(0) {}
+
+void IMultiAgentPathFinder::SetMap(const Map* new_map)
+{
+    CurrentMap = new_map;
+}
+
+bool IMultiAgentPathFinder::ValidateAgents(const std::vector<Agent>& agents) const
+{
+    if(CurrentMap == nullptr)
+    {
+        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nullptr!\n");
+        return false;
+    }
+    std::unordered_set<Coordinate, CoordinateHasher> starts, goals;
+    for(const Agent& agent : agents)
+    {
+        const Coordinate start = agent.GetStartCoordinate(), goal = agent.GetGoalCoordinate();
+        for(const Coordinate& coordinate : {start, goal})
+        {
+            if(!CurrentMap->IsValidCoordinate(coordinate))
+            {
+                DisplayInvalidCoordinateMessage(coordinate, CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+                return false;
+            }
+            if(!CurrentMap->IsPassableCoordinate(coordinate))
+            {
+                DisplayMessage(Red, __PRETTY_FUNCTION__, ": impassable start or goal ", coordinate, '\n');
+                return false;
+            }
+        }
+        if(!starts.insert(start).second || !goals.insert(goal).second)
+        {
+            DisplayMessage(Red, __PRETTY_FUNCTION__, ": agents share the start ", start, " or the goal ", goal, '\n');
+            return false;
+        }
+    }
+    return true;
+}
+
+unsigned long IMultiAgentPathFinder::GetSumOfCosts(const Paths& paths)
+{
+    unsigned long sum_of_costs = 0;
+    for(const auto& path : paths)
+    {
+        sum_of_costs += path->size() - 1;
+    }
+    return sum_of_costs;
+}
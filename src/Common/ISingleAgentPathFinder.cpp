@@ -1,51 +1,126 @@
 #include "../../include/Common/ISingleAgentPathFinder.h"
-#include <cmath>
+#include <array>
 #include "../../include/Common/Agent.h"
+#include "../../include/Common/Map.h" // GetLandmarks()
+#include "../../include/Common/Printer.h"
 
-using std::sqrt;
-using std::pow;
+// std::function counterparts of the policies, H and W stay meaningful whichever policy a solver is instantiated with
+// differential estimations depend on the map, its std::function counterpart is the Chebyshev bound it refines
+std::array<HeuristicFunction, NHeuristic> HeuristicsFunctions = {EuclideanPolicy(), ManhattanPolicy(), ChebyshevPolicy(),
+                                                             OctilePolicy(), ChebyshevPolicy()};
+std::array<WeightFunction, NWeight> WeightFunctions = {UnitWeightPolicy(), OctileWeightPolicy()};
 
-static inline double EuclideanDistance(Coordinate const& src, Coordinate const& dst)
+ISingleAgentPathFinder::ISingleAgentPathFinder(const Heuristic heuristic, const Weight weight):
+    CurrentMap(nullptr), H(HeuristicsFunctions[heuristic]), W(WeightFunctions[weight]), HeuristicType(heuristic),
+    WeightType(weight), IsCustomHeuristic(false), IsCustomWeight(false), Costs(DeduceCostStructure()),
+    TieOrder(ShallowTieBreak), NumberOfExpandedNodes(0), NumberOfGeneratedNodes(0), NumberOfPopOperations(0),
+    MaxHeapSize(0), PeakMemory(0) {}
+
+ISingleAgentPathFinder::ISingleAgentPathFinder(const Map* map, const Heuristic heuristic, const Weight weight):
+    CurrentMap(map), H(HeuristicsFunctions[heuristic]), W(WeightFunctions[weight]), HeuristicType(heuristic),
+    WeightType(weight), IsCustomHeuristic(false), IsCustomWeight(false), Costs(DeduceCostStructure()),
+    TieOrder(ShallowTieBreak), NumberOfExpandedNodes(0), NumberOfGeneratedNodes(0), NumberOfPopOperations(0),
+    MaxHeapSize(0), PeakMemory(0) {}
+
+ISingleAgentPathFinder::ISingleAgentPathFinder(const Map* map,
+                                               const HeuristicFunction& heuristic,
+                                               const WeightFunction& weight,
+                                               const CostStructure costs):
+    CurrentMap(map), H(heuristic), W(weight), HeuristicType(NHeuristic), WeightType(NWeight), IsCustomHeuristic(true),
+    IsCustomWeight(true), Costs(costs), TieOrder(ShallowTieBreak), NumberOfExpandedNodes(0), NumberOfGeneratedNodes(0),
+    NumberOfPopOperations(0), MaxHeapSize(0), PeakMemory(0) {}
+
+bool ISingleAgentPathFinder::IsGoal(const Coordinate& curr, const Coordinate& dst)
 {
-    return sqrt(pow(src.GetRow() - dst.GetRow(), 2.0) + pow(src.GetColumn() - dst.GetColumn(), 2.0));
+    return curr == dst;
 }
 
-static inline double ManhattanDistance(Coordinate const& src, Coordinate const& dst)
+bool ISingleAgentPathFinder::IsValidQuery(const char* caller, const Agent& agent, const bool is_goal_checked) const
 {
-    return abs(src.GetRow() - dst.GetRow()) + abs(src.GetColumn() - dst.GetColumn());
+    if(CurrentMap == nullptr)
+    {
+        DisplayMessage(Red, caller, ": CurrentMap is nullptr!\n");
+        return false;
+    }
+    // nodes are stored per map cell, a coordinate outside of the grid has no slot
+    for(const Coordinate& coordinate : {agent.GetStartCoordinate(), agent.GetGoalCoordinate()})
+    {
+        if(!CurrentMap->IsValidCoordinate(coordinate))
+        {
+            DisplayInvalidCoordinateMessage(coordinate, CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+            return false;
+        }
+        if(!is_goal_checked)
+        {
+            break;
+        }
+    }
+    return true;
 }
 
-static inline double DefaultWeightFunction(const Coordinate& src, const Coordinate& dst)
+void ISingleAgentPathFinder::SetMap(const Map* new_map)
 {
-    return src != dst ? 1 : 0;
+    CurrentMap = new_map;
 }
-std::array<HeuristicFunction, NHeuristic> HeuristicsFunctions = {EuclideanDistance, ManhattanDistance};
 
-ISingleAgentPathFinder::ISingleAgentPathFinder(const Heuristic heuristic):
-    CurrentMap(nullptr), H(HeuristicsFunctions[heuristic]), W(DefaultWeightFunction),
-    NumberOfExpandedNodes(0), NumberOfGeneratedNodes(0), NumberOfPopOperations(0), MaxHeapSize(0){}
+void ISingleAgentPathFinder::SetHeuristic(const Heuristic heuristic)
+{
+    H = HeuristicsFunctions[heuristic];
+    HeuristicType = heuristic;
+    IsCustomHeuristic = false;
+    Costs = DeduceCostStructure();
+}
 
-ISingleAgentPathFinder::ISingleAgentPathFinder(Map* map, const Heuristic heuristic):
-    CurrentMap(map), H(HeuristicsFunctions[heuristic]), W(DefaultWeightFunction),
-    NumberOfExpandedNodes(0), NumberOfGeneratedNodes(0), NumberOfPopOperations(0), MaxHeapSize(0){}
+void ISingleAgentPathFinder::SetWeight(const Weight weight)
+{
+    W = WeightFunctions[weight];
+    WeightType = weight;
+    IsCustomWeight = false;
+    Costs = DeduceCostStructure();
+}
 
-ISingleAgentPathFinder::ISingleAgentPathFinder(Map* map,
-                                               const HeuristicFunction& heuristic,
-                                               const WeightFunction& weight):
-    CurrentMap(map), H(heuristic), W(weight), NumberOfExpandedNodes(0),
-    NumberOfGeneratedNodes(0), NumberOfPopOperations(0), MaxHeapSize(0){}
+void ISingleAgentPathFinder::SetTieBreak(const TieBreak tie_break)
+{
+    TieOrder = tie_break;
+}
 
-bool ISingleAgentPathFinder::IsGoal(const Coordinate& curr, const Coordinate& dst)
+CostStructure ISingleAgentPathFinder::DeduceCostStructure(void) const
 {
-    return curr == dst;
+    // a custom function leaves no guarantee on the values it produces
+    if(IsCustomHeuristic || IsCustomWeight || HeuristicType == Euclidean)
+    {
+        return ArbitraryCost;
+    }
+    const bool is_integral_heuristic = HeuristicType == Manhattan || HeuristicType == Chebyshev ||
+                                       HeuristicType == Differential;
+    if(WeightType == UnitWeight)
+    {
+        return is_integral_heuristic ? IntegralCost : OctileCost;
+    }
+    // octile weight distances are stored in fixed point, their differences are not of the form a + b * sqrt(2)
+    return (HeuristicType == Differential) ? ArbitraryCost : OctileCost;
 }
 
-void ISingleAgentPathFinder::SetMap(Map* new_map)
+const LandmarkTable& ISingleAgentPathFinder::GetLandmarks(const Weight weight) const
 {
-    CurrentMap = new_map;
+    return CurrentMap->GetLandmarks(weight);
 }
 
-void ISingleAgentPathFinder::SetHeuristic(const Heuristic heuristic)
+OpenListType ISingleAgentPathFinder::SelectOpenList(const OpenListType open_list) const
 {
-    H = HeuristicsFunctions[heuristic];
+    if(TieOrder == DeepTieBreak && open_list != FibonacciHeapOpenList)
+    {
+        return QuaternaryHeapOpenList;
+    }
+    switch(open_list)
+    {
+        case AutomaticOpenList:
+            return (Costs == IntegralCost) ? IntegralBucketOpenList :
+                   (Costs == OctileCost) ? BucketOpenList : QuaternaryHeapOpenList;
+        case IntegralBucketOpenList:
+            // sorting a bucket by g alone is valid only when all of its f-values are equal
+            return (Costs == IntegralCost) ? IntegralBucketOpenList : BucketOpenList;
+        default:
+            return open_list;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "../../include/Common/Landmarks.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Directions.h" // eight_principle_directions
+#include <bit> // countr_zero()
+#include <queue> // priority_queue
+#include <limits>
+#include "../../include/Common/MappedFile.h"
+#include <cstring> // memcpy()
+#include <fstream> // ofstream
+
+LandmarkTable::LandmarkTable(): NumberOfRows(0), NumberOfColumns(0), NumberOfLandmarks(0), MoveWeight(UnitWeight), Scale(1),
+    InverseScale(1), Landmarks(), Distances(), MapDigest(0) {}
+
+void LandmarkTable::SetWeight(const Weight weight)
+{
+    // unit distances are exact integers. octile distances keep 5 fractional bits, which leaves room for 2047 moves
+    constexpr std::uint16_t OCTILE_SCALE = 32;
+    MoveWeight = weight;
+    Scale = (weight == OctileWeight) ? OCTILE_SCALE : 1;
+    InverseScale = 1.0 / Scale;
+}
+
+std::uint16_t LandmarkTable::DiagonalMoveDistance(void) const
+{
+    // rounded down, so a stored distance never exceeds the true one
+    return (MoveWeight == OctileWeight) ? static_cast<std::uint16_t>(SQRT2 * Scale) : Scale;
+}
+
+bool LandmarkTable::IsEmpty(void) const
+{
+    return Landmarks.empty();
+}
+
+std::size_t LandmarkTable::GetNumberOfLandmarks(void) const
+{
+    return NumberOfLandmarks;
+}
+
+Weight LandmarkTable::GetWeight(void) const
+{
+    return MoveWeight;
+}
+
+const std::vector<Coordinate>& LandmarkTable::GetLandmarks(void) const
+{
+    return Landmarks;
+}
+
+std::uint64_t LandmarkTable::Digest(const Map& map)
+{
+    // FNV-1a over the map shape and the neighbor mask of every cell, which determine all distances
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull, FNV_PRIME = 1099511628211ull;
+    std::uint64_t digest = FNV_OFFSET;
+    auto add = [&](const std::uint64_t value)
+    {
+        digest = (digest ^ value) * FNV_PRIME;
+    };
+    add(map.GetNumberOfRows());
+    add(map.GetNumberOfColumns());
+    for(int row = 0; row < map.GetNumberOfRows(); row++)
+    {
+        for(int column = 0; column < map.GetNumberOfColumns(); column++)
+        {
+            add(map.GetNeighborMask({row, column}));
+        }
+    }
+    return digest;
+}
+
+void LandmarkTable::Sweep(const Map& map, const Coordinate& source, std::vector<std::uint16_t>& distances) const
+{
+    // Dijkstra over the fixed point move distances, cells beyond the uint16 range remain unknown
+    using Entry = std::pair<std::uint32_t, Coordinate>; // distance, cell
+    auto is_farther = [](const Entry& e1, const Entry& e2){ return e1.first > e2.first; };
+    std::priority_queue<Entry, std::vector<Entry>, decltype(is_farther)> open_set(is_farther);
+    const std::uint32_t diagonal_move_distance = DiagonalMoveDistance();
+    constexpr std::size_t FIRST_DIAGONAL_DIRECTION = 4; // index of the first diagonal in eight_principle_directions
+
+    distances.assign(static_cast<std::size_t>(NumberOfRows) * NumberOfColumns, UNKNOWN_DISTANCE);
+    distances[CellIndex(source)] = 0;
+    open_set.emplace(0, source);
+    while(!open_set.empty())
+    {
+        const auto [distance, coordinate] = open_set.top();
+        open_set.pop();
+        if(distance > distances[CellIndex(coordinate)])
+        {
+            continue; // outdated entry
+        }
+        for(unsigned int directions = map.GetNeighborMask(coordinate); directions != 0; directions &= directions - 1)
+        {
+            const std::size_t direction_index = std::countr_zero(directions);
+            const Coordinate& direction = eight_principle_directions[direction_index];
+            const Coordinate neighbor = {coordinate.GetRow() + direction.GetRow(), coordinate.GetColumn() + direction.GetColumn()};
+            const std::uint32_t neighbor_distance = distance +
+                    ((direction_index < FIRST_DIAGONAL_DIRECTION) ? Scale : diagonal_move_distance);
+            std::uint16_t& stored_distance = distances[CellIndex(neighbor)];
+            if(neighbor_distance < stored_distance)
+            {
+                stored_distance = static_cast<std::uint16_t>(neighbor_distance);
+                open_set.emplace(neighbor_distance, neighbor);
+            }
+        }
+    }
+}
+
+void LandmarkTable::Build(const Map& map, const std::size_t number_of_landmarks, const Weight weight)
+{
+    SetWeight(weight);
+    NumberOfRows = map.GetNumberOfRows();
+    NumberOfColumns = map.GetNumberOfColumns();
+    MapDigest = Digest(map);
+    Landmarks.clear();
+    Distances.clear();
+    NumberOfLandmarks = 0;
+
+    const std::size_t number_of_cells = static_cast<std::size_t>(NumberOfRows) * NumberOfColumns;
+    std::vector<Coordinate> passable_cells;
+    for(int row = 0; row < NumberOfRows; row++)
+    {
+        for(int column = 0; column < NumberOfColumns; column++)
+        {
+            if(map.IsPassableCoordinate({row, column}))
+            {
+                passable_cells.emplace_back(row, column);
+            }
+        }
+    }
+    if(passable_cells.empty() || number_of_landmarks == 0)
+    {
+        return;
+    }
+
+    /*
+     * Farthest-point selection: the next landmark is the cell farthest from all landmarks chosen so far,
+     * where cells not reached by any of them are the farthest, so every component gets a landmark in turn.
+     * The first landmark is the cell farthest from an arbitrary seed, which tends to lie on the map border.
+     */
+    constexpr std::uint32_t INFINITE_DISTANCE = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> nearest_landmark_distance(number_of_cells, INFINITE_DISTANCE);
+    std::vector<std::vector<std::uint16_t>> sweeps;
+    std::vector<std::uint16_t> distances;
+    Sweep(map, passable_cells.front(), distances);
+    Coordinate farthest = passable_cells.front();
+    for(const Coordinate& cell : passable_cells)
+    {
+        const std::uint16_t distance = distances[CellIndex(cell)];
+        if(distance != UNKNOWN_DISTANCE && distance > distances[CellIndex(farthest)])
+        {
+            farthest = cell;
+        }
+    }
+
+    while(true)
+    {
+        Landmarks.push_back(farthest);
+        Sweep(map, farthest, distances);
+        for(const Coordinate& cell : passable_cells)
+        {
+            const std::uint16_t distance = distances[CellIndex(cell)];
+            std::uint32_t& nearest = nearest_landmark_distance[CellIndex(cell)];
+            if(distance != UNKNOWN_DISTANCE)
+            {
+                nearest = std::min<std::uint32_t>(nearest, distance);
+            }
+        }
+        sweeps.push_back(std::move(distances));
+        if(Landmarks.size() == number_of_landmarks)
+        {
+            break;
+        }
+        for(const Coordinate& cell : passable_cells)
+        {
+            if(nearest_landmark_distance[CellIndex(cell)] > nearest_landmark_distance[CellIndex(farthest)])
+            {
+                farthest = cell;
+            }
+        }
+        if(nearest_landmark_distance[CellIndex(farthest)] == 0)
+        {
+            break; // every passable cell is a landmark already
+        }
+    }
+
+    NumberOfLandmarks = Landmarks.size();
+    Distances.assign(number_of_cells * NumberOfLandmarks, UNKNOWN_DISTANCE);
+    for(std::size_t cell = 0; cell < number_of_cells; cell++)
+    {
+        for(std::size_t landmark = 0; landmark < NumberOfLandmarks; landmark++)
+        {
+            Distances[cell * NumberOfLandmarks + landmark] = sweeps[landmark][cell];
+        }
+    }
+}
+
+bool LandmarkTable::Save(const char* path) const
+{
+    std::ofstream file(path, std::ios::out | std::ios::binary);
+    return file && Save(file);
+}
+
+bool LandmarkTable::Save(std::ostream& file) const
+{
+    /*
+     * Binary layout, in host byte order:
+     * "LMK1"  rows  columns  number of landmarks  weight (uint32 each)  map digest (uint64)
+     * row and column of each landmark (int32 each)  distances (uint16 each, cell-major)
+     */
+    const std::uint32_t header[] = {static_cast<std::uint32_t>(NumberOfRows), static_cast<std::uint32_t>(NumberOfColumns),
+                                    static_cast<std::uint32_t>(NumberOfLandmarks), static_cast<std::uint32_t>(MoveWeight)};
+    file.write("LMK1", 4);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&MapDigest), sizeof(MapDigest));
+    for(const Coordinate& landmark : Landmarks)
+    {
+        const std::int32_t coordinate[] = {landmark.GetRow(), landmark.GetColumn()};
+        file.write(reinterpret_cast<const char*>(coordinate), sizeof(coordinate));
+    }
+    file.write(reinterpret_cast<const char*>(Distances.data()), Distances.size() * sizeof(std::uint16_t));
+    return static_cast<bool>(file);
+}
+
+bool LandmarkTable::Load(const char* path, const Map& map)
+{
+    MappedFile file;
+    return file.Open(path) && Load(file.GetView(), map);
+}
+
+bool LandmarkTable::Load(std::string_view content, const Map& map)
+{
+    // copy the next bytes of content into value, fails if content is too short
+    auto read = [&content](void* value, const std::size_t size)
+    {
+        if(content.size() < size)
+        {
+            return false;
+        }
+        std::memcpy(value, content.data(), size);
+        content.remove_prefix(size);
+        return true;
+    };
+    char magic[4];
+    std::uint32_t header[4];
+    std::uint64_t digest;
+    if(!read(magic, sizeof(magic)) || std::string_view(magic, sizeof(magic)) != "LMK1" ||
+       !read(header, sizeof(header)) || !read(&digest, sizeof(digest)))
+    {
+        return false;
+    }
+    // a table of another map, or of an older version of this map, is of no use
+    if(static_cast<int>(header[0]) != map.GetNumberOfRows() || static_cast<int>(header[1]) != map.GetNumberOfColumns() ||
+       header[3] >= NWeight || digest != Digest(map))
+    {
+        return false;
+    }
+
+    const std::size_t number_of_landmarks = header[2];
+    std::vector<Coordinate> landmarks;
+    for(std::size_t i = 0; i < number_of_landmarks; i++)
+    {
+        std::int32_t coordinate[2];
+        if(!read(coordinate, sizeof(coordinate)))
+        {
+            return false;
+        }
+        landmarks.emplace_back(coordinate[0], coordinate[1]);
+    }
+    std::vector<std::uint16_t> distances(static_cast<std::size_t>(header[0]) * header[1] * number_of_landmarks);
+    if(!read(distances.data(), distances.size() * sizeof(std::uint16_t)))
+    {
+        return false;
+    }
+
+    NumberOfRows = header[0];
+    NumberOfColumns = header[1];
+    NumberOfLandmarks = number_of_landmarks;
+    SetWeight(static_cast<Weight>(header[3]));
+    MapDigest = digest;
+    Landmarks = std::move(landmarks);
+    Distances = std::move(distances);
+    return true;
+}
@@ -1,37 +1,352 @@
 #include "../../include/Common/Map.h"
 #include "../../include/Common/Agent.h" // GetStartCoordinate(), GetGoalCoordinate()
-#include "../../include/Common/Printer.h" // DisplayInvalidCoordinateMessage()
-#include <algorithm> // any_of()
-#include <fstream>// ifstream, ofstream
-#include <sstream> // GetGrid()
+#include "../../include/Common/Directions.h" // eight_principle_directions
+#include "../../include/Common/Printer.h"
+#include <algorithm> // any_of(), fill(), find(), remove(), min()
+#include <charconv> // from_chars()
+#include <cctype> // isspace(), isprint()
+#include <limits>
+#include <cstring> // memcpy()
+#include <fstream> // ofstream
+#include <sstream> // GetGrid(), SaveCompiled()
 
-Map::Map() : NumberOfRows(0), NumberOfColumns(0), Grid() {}
-Map::Map(char* const path) : NumberOfRows(0), NumberOfColumns(0), Grid() { Load(path);}
-
-bool Map::IsValidCoordinate(Coordinate const& coordinate)
+Map::Map() : NumberOfRows(0), NumberOfColumns(0), GridStorage(), PassableStorage(), MaskStorage(), ComponentStorage(), Compiled(), Grid(nullptr),
+    PassableBits(nullptr), NeighborMasks(nullptr), ComponentIds(nullptr),
+    NumberOfComponents(0), NeighborOffsets(), SourceChecksum(0), Landmarks(), Version(0), Observers() {}
+Map::Map(char* const path) : NumberOfRows(0), NumberOfColumns(0), GridStorage(), PassableStorage(), MaskStorage(), ComponentStorage(), Compiled(),
+    Grid(nullptr), PassableBits(nullptr), NeighborMasks(nullptr), ComponentIds(nullptr),
+    NumberOfComponents(0), NeighborOffsets(), SourceChecksum(0), Landmarks(), Version(0), Observers()
 {
-    return coordinate.GetRow() < NumberOfRows && coordinate.GetRow() >= 0 && coordinate.GetColumn() >= 0 && coordinate.GetColumn() < NumberOfColumns;
+    Load(path);
 }
 
-bool Map::IsPassableCoordinate(Coordinate const& coordinate)
+bool Map::IsPassableTerrain(unsigned char const terrain)
 {
     constexpr size_t NUMBER_OF_PASSABLE_TERRAIN = 4;
     std::array<unsigned char, NUMBER_OF_PASSABLE_TERRAIN> passable_terrains = {'.', 'G', 'S', 'W'};
-    
-    auto terrain = Grid[coordinate.GetRow()][coordinate.GetColumn()];
     return std::any_of(passable_terrains.begin(), passable_terrains.end(), [&](const auto& t){return terrain == t;});
 }
 
-bool Map::Load(const char *path)
+std::uint64_t Map::Checksum(std::string_view content)
 {
-    std::ifstream file(path, std::ios::in);
+    // FNV-1a over 8 byte words, then over the remaining bytes
+    constexpr std::uint64_t FNV_OFFSET = 14695981039346656037ull, FNV_PRIME = 1099511628211ull;
+    std::uint64_t checksum = FNV_OFFSET;
+    for(; content.size() >= sizeof(std::uint64_t); content.remove_prefix(sizeof(std::uint64_t)))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, content.data(), sizeof(word));
+        checksum = (checksum ^ word) * FNV_PRIME;
+    }
+    for(const char byte : content)
+    {
+        checksum = (checksum ^ static_cast<unsigned char>(byte)) * FNV_PRIME;
+    }
+    return checksum;
+}
 
-    if(!file)
+inline std::size_t Map::CellIndex(int const row, int const column) const
+{
+    return static_cast<std::size_t>(row) * NumberOfColumns + column;
+}
+
+inline std::size_t Map::PaddedIndex(int const row, int const column) const
+{
+    return static_cast<std::size_t>(row + 1) * (NumberOfColumns + 2) + (column + 1);
+}
+
+inline bool Map::IsPassableCell(int const row, int const column) const
+{
+    constexpr std::size_t WORD_SIZE = 64;
+    const std::size_t index = PaddedIndex(row, column);
+    return (PassableBits[index / WORD_SIZE] >> (index % WORD_SIZE)) & 1;
+}
+
+void Map::SetDimensions(int const rows, int const columns)
+{
+    NumberOfRows = rows;
+    NumberOfColumns = columns;
+    for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+    {
+        NeighborOffsets[i] = eight_principle_directions[i].GetRow() * columns + eight_principle_directions[i].GetColumn();
+    }
+}
+
+void Map::BuildNeighborMasks(void)
+{
+    constexpr std::size_t WORD_SIZE = 64;
+    const std::size_t padded_columns = NumberOfColumns + 2;
+    // a byte per padded cell, so that the masks of a row are assembled direction by direction in vectorizable loops
+    std::vector<std::uint8_t> is_passable(static_cast<std::size_t>(NumberOfRows + 2) * padded_columns);
+    for(std::size_t index = 0; index < is_passable.size(); index++)
+    {
+        is_passable[index] = (PassableBits[index / WORD_SIZE] >> (index % WORD_SIZE)) & 1;
+    }
+
+    MaskStorage.assign(static_cast<std::size_t>(NumberOfRows) * NumberOfColumns, 0);
+    NeighborMasks = MaskStorage.data();
+    for(int row = 0; row < NumberOfRows; row++)
+    {
+        std::uint8_t* const masks = NeighborMasks + CellIndex(row, 0);
+        for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+        {
+            const Coordinate& direction = eight_principle_directions[i];
+            const std::uint8_t* const neighbors = is_passable.data() + PaddedIndex(row + direction.GetRow(), direction.GetColumn());
+            for(int column = 0; column < NumberOfColumns; column++)
+            {
+                masks[column] |= neighbors[column] << i;
+            }
+        }
+    }
+}
+
+void Map::BuildComponents(void)
+{
+    ComponentStorage.assign(static_cast<std::size_t>(NumberOfRows) * NumberOfColumns, 0);
+    ComponentIds = ComponentStorage.data();
+    NumberOfComponents = 0;
+    for(int row = 0; row < NumberOfRows; row++)
+    {
+        for(int column = 0; column < NumberOfColumns; column++)
+        {
+            const std::size_t index = CellIndex(row, column);
+            if(ComponentIds[index] == 0 && IsPassableCell(row, column))
+            {
+                LabelComponent(index, ++NumberOfComponents);
+            }
+        }
+    }
+}
+
+void Map::LabelComponent(std::size_t const index, std::uint32_t const component)
+{
+    // depth first over the cells reachable from index whose label differs, each cell is pushed once
+    std::vector<std::size_t> stack = {index};
+    ComponentIds[index] = component;
+    while(!stack.empty())
+    {
+        const std::size_t current = stack.back();
+        stack.pop_back();
+        const std::uint8_t mask = NeighborMasks[current];
+        for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+        {
+            if((mask >> i) & 1)
+            {
+                // a set bit implies the neighbor lies within the grid, hence its row-major index does not wrap
+                const Coordinate& direction = eight_principle_directions[i];
+                const std::size_t neighbor = current + static_cast<std::ptrdiff_t>(direction.GetRow()) * NumberOfColumns + direction.GetColumn();
+                if(ComponentIds[neighbor] != component)
+                {
+                    ComponentIds[neighbor] = component;
+                    stack.push_back(neighbor);
+                }
+            }
+        }
+    }
+}
+
+void Map::UpdateComponents(int const row, int const column)
+{
+    const std::size_t index = CellIndex(row, column);
+    if(!IsPassableCell(row, column))
+    {
+        // the remaining cells keep their label, a split is not looked for
+        ComponentIds[index] = 0;
+        return;
+    }
+    // join the component of a passable neighbor, and relabel the others it connects to
+    const std::uint8_t mask = NeighborMasks[index];
+    std::uint32_t component = 0;
+    bool is_merge = false;
+    for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+    {
+        if((mask >> i) & 1)
+        {
+            const Coordinate& direction = eight_principle_directions[i];
+            const std::uint32_t neighbor_component = ComponentIds[CellIndex(row + direction.GetRow(), column + direction.GetColumn())];
+            is_merge |= component != 0 && neighbor_component != component;
+            component = (component == 0) ? neighbor_component : component;
+        }
+    }
+    if(component == 0)
+    {
+        ComponentIds[index] = ++NumberOfComponents;
+    }
+    else if(is_merge)
+    {
+        LabelComponent(index, component);
+    }
+    else
+    {
+        ComponentIds[index] = component;
+    }
+}
+
+void Map::UpdateNeighborMasks(int const row, int const column)
+{
+    // the neighbor in direction i reaches the cell along the opposite direction, whose index is opposite_directions[i]
+    constexpr std::array<std::size_t, 8> opposite_directions = {1, 0, 3, 2, 7, 6, 5, 4};
+    const bool is_passable = IsPassableCell(row, column);
+    for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+    {
+        const int neighbor_row = row + eight_principle_directions[i].GetRow();
+        const int neighbor_column = column + eight_principle_directions[i].GetColumn();
+        if(IsValidCoordinate({neighbor_row, neighbor_column}))
+        {
+            std::uint8_t& mask = NeighborMasks[CellIndex(neighbor_row, neighbor_column)];
+            const std::uint8_t bit = std::uint8_t(1) << opposite_directions[i];
+            mask = is_passable ? (mask | bit) : (mask & ~bit);
+        }
+    }
+}
+
+bool Map::IsValidCoordinate(Coordinate const& coordinate) const
+{
+    return coordinate.GetRow() < NumberOfRows && coordinate.GetRow() >= 0 && coordinate.GetColumn() >= 0 && coordinate.GetColumn() < NumberOfColumns;
+}
+
+bool Map::IsPassableCoordinate(Coordinate const& coordinate) const
+{
+    return IsPassableCell(coordinate.GetRow(), coordinate.GetColumn());
+}
+
+CellId Map::GetCellId(Coordinate const& coordinate) const
+{
+    return static_cast<CellId>(CellIndex(coordinate.GetRow(), coordinate.GetColumn()));
+}
+
+Coordinate Map::GetCoordinate(CellId const cell) const
+{
+    const auto columns = static_cast<CellId>(NumberOfColumns);
+    return {static_cast<int>(cell / columns), static_cast<int>(cell % columns)};
+}
+
+std::uint8_t Map::GetNeighborMask(Coordinate const& coordinate) const
+{
+    return NeighborMasks[CellIndex(coordinate.GetRow(), coordinate.GetColumn())];
+}
+
+std::uint8_t Map::GetNeighborMask(CellId const cell) const
+{
+    return NeighborMasks[cell];
+}
+
+const std::array<std::int32_t, 8>& Map::GetNeighborOffsets(void) const
+{
+    return NeighborOffsets;
+}
+
+std::uint32_t Map::GetComponent(Coordinate const& coordinate) const
+{
+    return ComponentIds[CellIndex(coordinate.GetRow(), coordinate.GetColumn())];
+}
+
+bool Map::AreConnected(Coordinate const& first, Coordinate const& second) const
+{
+    if(!IsValidCoordinate(first) || !IsValidCoordinate(second))
     {
         return false;
     }
+    const std::uint32_t component = GetComponent(first);
+    return component != 0 && component == GetComponent(second);
+}
+
+std::uint64_t Map::GetVersion(void) const
+{
+    return Version;
+}
+
+bool Map::SetPassable(Coordinate const& coordinate, bool const is_passable)
+{
+    constexpr std::size_t WORD_SIZE = 64;
+    constexpr unsigned char PASSABLE_TERRAIN = '.', IMPASSABLE_TERRAIN = '@';
+    if(!IsValidCoordinate(coordinate))
+    {
+        return false;
+    }
+    const int row = coordinate.GetRow(), column = coordinate.GetColumn();
+    if(IsPassableCell(row, column) == is_passable)
+    {
+        return true;
+    }
+
+    Grid[CellIndex(row, column)] = is_passable ? PASSABLE_TERRAIN : IMPASSABLE_TERRAIN;
+    const std::size_t index = PaddedIndex(row, column);
+    PassableBits[index / WORD_SIZE] ^= std::uint64_t(1) << (index % WORD_SIZE);
+    UpdateNeighborMasks(row, column);
+    UpdateComponents(row, column);
+    SourceChecksum = 0;
+    Landmarks.fill(LandmarkTable()); // distances of the former grid
+    Version++;
+    for(IMapObserver* observer : Observers)
+    {
+        observer->OnPassabilityChanged(*this, coordinate);
+    }
+    return true;
+}
+
+void Map::AddObserver(IMapObserver* observer) const
+{
+    if(std::find(Observers.begin(), Observers.end(), observer) == Observers.end())
+    {
+        Observers.push_back(observer);
+    }
+}
+
+void Map::RemoveObserver(IMapObserver* observer) const
+{
+    Observers.erase(std::remove(Observers.begin(), Observers.end(), observer), Observers.end());
+}
+
+const LandmarkTable& Map::GetLandmarks(const Weight weight) const
+{
+    return Landmarks[weight];
+}
+
+void Map::SetLandmarks(LandmarkTable&& landmarks)
+{
+    const Weight weight = landmarks.GetWeight();
+    Landmarks[weight] = std::move(landmarks);
+}
+
+bool Map::Load(const char *path)
+{
+    constexpr std::size_t WORD_SIZE = 64;
+    const char* const function = __PRETTY_FUNCTION__;
+    MappedFile file;
+    if(!file.Open(path))
+    {
+        DisplayMessage(Red, function, ": cannot open ", path, '\n');
+        return false;
+    }
+
+    const std::string_view content = file.GetView();
+    const std::uint64_t checksum = Checksum(content);
+    std::size_t position = 0, line_number = 0;
+    std::string_view line;
+    // advance to the next line, without its line break
+    auto next_line = [&]()
+    {
+        if(position >= content.size())
+        {
+            return false;
+        }
+        const std::size_t end = std::min(content.find('\n', position), content.size());
+        line = content.substr(position, end - position);
+        if(!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        position = end + 1;
+        line_number++;
+        return true;
+    };
+    auto report = [&](const auto&... message)
+    {
+        DisplayMessage(Red, function, ": ", path, ':', line_number, ": ", message..., '\n');
+        return false;
+    };
 
-    std::string type, space, octile, height, width, map, line;
     /*
         All maps begin with the lines:
         type octile
@@ -39,70 +354,406 @@ bool Map::Load(const char *path)
         width x
         map
     */
-    file >> type >> octile >> height >> NumberOfRows >> width >> NumberOfColumns >> map;
+    int rows = -1, columns = -1;
+    bool is_header_done = false;
+    while(!is_header_done && next_line())
+    {
+        const std::size_t key_end = std::min(line.find_first_of(" \t"), line.size());
+        const std::string_view key = line.substr(0, key_end);
+        std::string_view value = line.substr(key_end);
+        value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+        if(key == "height" || key == "width")
+        {
+            int& dimension = (key == "height") ? rows : columns;
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), dimension);
+            if(error != std::errc() || end != value.data() + value.size() || dimension <= 0)
+            {
+                return report("invalid ", key, " '", value, "'");
+            }
+        }
+        else if(key == "map")
+        {
+            is_header_done = true;
+        }
+        else if(key != "type" && !key.empty())
+        {
+            return report("unexpected header line '", line, "'");
+        }
+    }
+    if(!is_header_done || rows < 0 || columns < 0)
+    {
+        return report("header lacks ", (rows < 0) ? "height" : (columns < 0) ? "width" : "the map line");
+    }
+    // every tile takes a byte, which bounds the grid before allocating it
+    if(static_cast<std::uint64_t>(rows) * columns > content.size() - std::min(position, content.size()))
+    {
+        return report("file is too short for a grid of height ", rows, " and width ", columns);
+    }
 
-    int row = 0, i = 0;
-    constexpr unsigned char NUMBER_OF_CARRIAGE_LITERALS = 32;
-    bool advance_next_row = false;
-    Grid.resize(NumberOfRows);
-    while(getline(file, line))
+    // terrain and passability bitmap are filled in a single pass over the mapped rows, see PaddedIndex()
+    grid_t grid(static_cast<std::size_t>(rows) * columns);
+    std::vector<std::uint64_t> passable_bits((static_cast<std::size_t>(rows + 2) * (columns + 2) + WORD_SIZE - 1) / WORD_SIZE, 0);
+    for(int row = 0; row < rows; row++)
     {
-        Grid[row].resize(NumberOfColumns);
-        for(const auto& tile : line)
+        if(!next_line())
         {
-            if(tile > NUMBER_OF_CARRIAGE_LITERALS)
+            return report("expected ", rows, " rows, found ", row);
+        }
+        if(line.size() != static_cast<std::size_t>(columns))
+        {
+            return report("row ", row, " has ", line.size(), " tiles, expected ", columns);
+        }
+        unsigned char* const grid_row = grid.data() + static_cast<std::size_t>(row) * columns;
+        for(int column = 0; column < columns; column++)
+        {
+            const unsigned char terrain = line[column];
+            if(std::isspace(terrain) || !std::isprint(terrain))
             {
-                Grid[row][i++] = tile;
-                advance_next_row = true;
+                return report("row ", row, " has invalid terrain at column ", column);
+            }
+            grid_row[column] = terrain;
+            if(IsPassableTerrain(terrain))
+            {
+                const std::size_t index = static_cast<std::size_t>(row + 1) * (columns + 2) + (column + 1);
+                passable_bits[index / WORD_SIZE] |= std::uint64_t(1) << (index % WORD_SIZE);
             }
         }
-        if(advance_next_row)
+    }
+    while(next_line())
+    {
+        if(line.find_first_not_of(" \t") != std::string_view::npos)
         {
-            row++;
-            i = 0;
+            return report("unexpected data after the last of ", rows, " rows");
         }
-        advance_next_row = false;
     }
-    file.close();
+
+    // the former grid is kept unless the whole file is valid
+    SetDimensions(rows, columns);
+    GridStorage = std::move(grid);
+    PassableStorage = std::move(passable_bits);
+    Grid = GridStorage.data();
+    PassableBits = PassableStorage.data();
+    BuildNeighborMasks();
+    BuildComponents();
+    Compiled.Close();
+    SourceChecksum = checksum;
+    Landmarks.fill(LandmarkTable()); // distances of the former grid
+    Version++;
     return true;
 }
 
-void Map::SetAgent(Agent const& agent)
+/*
+ * Binary layout of a compiled map, in host byte order:
+ * header    "MAPC"  format version  rows  columns  number of sections  reserved (uint32 each)  source checksum (uint64)
+ * sections  type  parameter (uint32 each)  offset  size (uint64 each), for every section
+ * payloads  each starts at a multiple of COMPILED_ALIGNMENT bytes, so that it is used in place from the mapping
+ * A grid changed after loading is saved with checksum 0, which no source matches.
+ */
+constexpr std::uint32_t COMPILED_FORMAT_VERSION = 2;
+constexpr std::size_t COMPILED_ALIGNMENT = 64;
+
+struct CompiledHeader
 {
-    constexpr unsigned char AGENT_MARKER = 'A';
-    constexpr unsigned char GOAL_MARKER = 'G';
-    
-    Coordinate const& start_coordinate = agent.GetStartCoordinate(), goal_coordinate = agent.GetGoalCoordinate();
-    if(!IsValidCoordinate(start_coordinate))
+    char Magic[4];
+    std::uint32_t FormatVersion, NumberOfRows, NumberOfColumns, NumberOfSections, Reserved;
+    std::uint64_t SourceChecksum;
+};
+
+struct CompiledSection
+{
+    std::uint32_t Type, Parameter;
+    std::uint64_t Offset, Size;
+};
+
+typedef enum CompiledSectionType
+{
+    TerrainSection, // a byte per cell
+    PassabilitySection, // padded passability bitmap
+    NeighborMaskSection, // a byte per cell
+    ComponentSection, // a label of 4 bytes per cell, parameter is the number of labels handed out
+    LandmarkSection // a landmark table in the layout of LandmarkTable::Save(), parameter is its weight
+}CompiledSectionType;
+
+bool Map::SaveCompiled(const char* path) const
+{
+    constexpr std::size_t WORD_SIZE = 64;
+    const std::size_t number_of_cells = static_cast<std::size_t>(NumberOfRows) * NumberOfColumns;
+    const std::size_t number_of_words = (static_cast<std::size_t>(NumberOfRows + 2) * (NumberOfColumns + 2) + WORD_SIZE - 1) / WORD_SIZE;
+    if(Grid == nullptr)
     {
-        DisplayInvalidCoordinateMessage(start_coordinate, NumberOfRows, NumberOfColumns);
-        return;
+        DisplayMessage(Red, __PRETTY_FUNCTION__, ": no map is loaded\n");
+        return false;
     }
-    if(!IsValidCoordinate(goal_coordinate))
+    std::vector<std::string> landmark_payloads;
+    std::vector<std::pair<CompiledSection, const char*>> sections = {
+        {{TerrainSection, 0, 0, number_of_cells}, reinterpret_cast<const char*>(Grid)},
+        {{PassabilitySection, 0, 0, number_of_words * sizeof(std::uint64_t)}, reinterpret_cast<const char*>(PassableBits)},
+        {{NeighborMaskSection, 0, 0, number_of_cells}, reinterpret_cast<const char*>(NeighborMasks)},
+        {{ComponentSection, NumberOfComponents, 0, number_of_cells * sizeof(std::uint32_t)}, reinterpret_cast<const char*>(ComponentIds)}};
+    landmark_payloads.reserve(Landmarks.size()); // sections point into the payloads
+    for(const LandmarkTable& landmarks : Landmarks)
     {
-        DisplayInvalidCoordinateMessage(start_coordinate, NumberOfRows, NumberOfColumns);
-        return;
+        std::ostringstream payload;
+        if(!landmarks.IsEmpty() && landmarks.Save(payload))
+        {
+            landmark_payloads.push_back(payload.str());
+            sections.push_back({{LandmarkSection, static_cast<std::uint32_t>(landmarks.GetWeight()), 0, landmark_payloads.back().size()},
+                                landmark_payloads.back().data()});
+        }
     }
-    Grid[start_coordinate.GetRow()][start_coordinate.GetColumn()] = AGENT_MARKER;
-    Grid[goal_coordinate.GetRow()][goal_coordinate.GetColumn()] = GOAL_MARKER;
+
+    auto align = [](const std::uint64_t offset){ return (offset + COMPILED_ALIGNMENT - 1) / COMPILED_ALIGNMENT * COMPILED_ALIGNMENT; };
+    std::uint64_t offset = align(sizeof(CompiledHeader) + sections.size() * sizeof(CompiledSection));
+    for(auto& [section, data] : sections)
+    {
+        section.Offset = offset;
+        offset = align(offset + section.Size);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file)
+    {
+        DisplayMessage(Red, __PRETTY_FUNCTION__, ": cannot create ", path, '\n');
+        return false;
+    }
+    const CompiledHeader header = {{'M', 'A', 'P', 'C'}, COMPILED_FORMAT_VERSION, static_cast<std::uint32_t>(NumberOfRows),
+                                   static_cast<std::uint32_t>(NumberOfColumns), static_cast<std::uint32_t>(sections.size()),
+                                   0, SourceChecksum};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(const auto& [section, data] : sections)
+    {
+        file.write(reinterpret_cast<const char*>(&section), sizeof(section));
+    }
+    for(const auto& [section, data] : sections)
+    {
+        const std::string padding(section.Offset - static_cast<std::uint64_t>(file.tellp()), '\0');
+        file.write(padding.data(), padding.size());
+        file.write(data, section.Size);
+    }
+    return static_cast<bool>(file);
 }
 
-void Map::RemoveAgent(Agent const& agent)
+bool Map::LoadCompiled(const char* path, const char* source_path)
 {
-    static constexpr unsigned char EMPTY_TERRAIN_MARKER = '.';
-    Coordinate const& start_coordinate = agent.GetStartCoordinate(), goal_coordinate = agent.GetGoalCoordinate();
-    if(!IsValidCoordinate(start_coordinate))
+    constexpr std::size_t WORD_SIZE = 64;
+    const char* const function = __PRETTY_FUNCTION__;
+    auto report = [&](const auto&... message)
     {
-        DisplayInvalidCoordinateMessage(start_coordinate, NumberOfRows, NumberOfColumns);
-        return;
+        DisplayMessage(Red, function, ": ", path, ": ", message..., '\n');
+        return false;
+    };
+    MappedFile file;
+    if(!file.Open(path, true))
+    {
+        return report("cannot open");
     }
-    if(!IsValidCoordinate(goal_coordinate))
+    const std::string_view content = file.GetView();
+    CompiledHeader header;
+    if(content.size() < sizeof(header))
     {
-        DisplayInvalidCoordinateMessage(start_coordinate, NumberOfRows, NumberOfColumns);
-        return;
+        return report("too short for a compiled map");
+    }
+    std::memcpy(&header, content.data(), sizeof(header));
+    if(std::string_view(header.Magic, sizeof(header.Magic)) != "MAPC" || header.FormatVersion != COMPILED_FORMAT_VERSION)
+    {
+        return report("not a compiled map of format version ", COMPILED_FORMAT_VERSION);
     }
-    Grid[start_coordinate.GetRow()][start_coordinate.GetColumn()] = EMPTY_TERRAIN_MARKER;
-    Grid[goal_coordinate.GetRow()][goal_coordinate.GetColumn()] = EMPTY_TERRAIN_MARKER;
+    const std::uint64_t rows = header.NumberOfRows, columns = header.NumberOfColumns;
+    if(rows == 0 || columns == 0 || rows >= std::numeric_limits<int>::max() - 2 || columns >= std::numeric_limits<int>::max() - 2 ||
+       content.size() < sizeof(header) + static_cast<std::uint64_t>(header.NumberOfSections) * sizeof(CompiledSection))
+    {
+        return report("malformed header");
+    }
+    if(source_path != nullptr)
+    {
+        MappedFile source;
+        if(!source.Open(source_path) || Checksum(source.GetView()) != header.SourceChecksum)
+        {
+            DisplayMessage(Yellow, path, " was not compiled from the current ", source_path, '\n');
+            return false;
+        }
+    }
+
+    // every section is checked to lie within the file before the grid is replaced
+    const std::uint64_t number_of_cells = rows * columns;
+    const std::uint64_t number_of_words = ((rows + 2) * (columns + 2) + WORD_SIZE - 1) / WORD_SIZE;
+    char* const data = file.GetWritableData();
+    unsigned char* grid = nullptr;
+    std::uint64_t* passable_bits = nullptr;
+    std::uint8_t* neighbor_masks = nullptr;
+    std::uint32_t* component_ids = nullptr;
+    std::uint32_t number_of_components = 0;
+    std::vector<std::string_view> landmark_payloads;
+    for(std::uint32_t i = 0; i < header.NumberOfSections; i++)
+    {
+        CompiledSection section;
+        std::memcpy(&section, content.data() + sizeof(header) + i * sizeof(CompiledSection), sizeof(section));
+        if(section.Offset % COMPILED_ALIGNMENT != 0 || section.Offset > content.size() || section.Size > content.size() - section.Offset)
+        {
+            return report("section ", i, " lies outside of the file");
+        }
+        char* const payload = data + section.Offset;
+        const bool is_valid = (section.Type == TerrainSection && section.Size == number_of_cells) ||
+                              (section.Type == PassabilitySection && section.Size == number_of_words * sizeof(std::uint64_t)) ||
+                              (section.Type == NeighborMaskSection && section.Size == number_of_cells) ||
+                              (section.Type == ComponentSection && section.Size == number_of_cells * sizeof(std::uint32_t)) ||
+                              section.Type == LandmarkSection;
+        if(!is_valid)
+        {
+            return report("section ", i, " of type ", section.Type, " has an unexpected size of ", section.Size, " bytes");
+        }
+        switch(section.Type)
+        {
+            case TerrainSection:
+                grid = reinterpret_cast<unsigned char*>(payload);
+                break;
+            case PassabilitySection:
+                passable_bits = reinterpret_cast<std::uint64_t*>(payload);
+                break;
+            case NeighborMaskSection:
+                neighbor_masks = reinterpret_cast<std::uint8_t*>(payload);
+                break;
+            case ComponentSection:
+                component_ids = reinterpret_cast<std::uint32_t*>(payload);
+                number_of_components = section.Parameter;
+                break;
+            default:
+                landmark_payloads.emplace_back(payload, section.Size);
+        }
+    }
+    if(grid == nullptr || passable_bits == nullptr || neighbor_masks == nullptr || component_ids == nullptr)
+    {
+        return report("lacks the terrain, passability, neighbor mask or component section");
+    }
+    // solvers follow the neighbor masks without bounds checks, and the source check is skipped when a compiled map
+    // is opened directly, hence the derived sections are verified against the terrain, in O(cells). as when they are
+    // built, passability is unpacked to a byte per padded cell, and mismatches are accumulated without branches, so
+    // that rows are checked in vectorizable loops
+    std::array<std::uint8_t, 256> passable_terrains;
+    for(std::size_t terrain = 0; terrain < passable_terrains.size(); terrain++)
+    {
+        passable_terrains[terrain] = IsPassableTerrain(static_cast<unsigned char>(terrain));
+    }
+    const std::uint8_t* const is_passable_terrain = passable_terrains.data();
+    const std::uint64_t padded_columns = columns + 2;
+    std::vector<std::uint8_t> passable_cells((rows + 2) * padded_columns);
+    std::uint8_t* const is_passable = passable_cells.data();
+    for(std::uint64_t index = 0; index < passable_cells.size(); index++)
+    {
+        is_passable[index] = (passable_bits[index / WORD_SIZE] >> (index % WORD_SIZE)) & 1;
+    }
+    std::uint32_t mismatches = 0;
+    // the frame is impassable
+    for(std::uint64_t column = 0; column < padded_columns; column++)
+    {
+        mismatches |= is_passable[column] | is_passable[(rows + 1) * padded_columns + column];
+    }
+    for(std::uint64_t row = 0; row < rows; row++)
+    {
+        const std::uint8_t* const cells = is_passable + (row + 1) * padded_columns;
+        const unsigned char* const terrains = grid + row * columns;
+        mismatches |= cells[0] | cells[columns + 1];
+        for(std::uint64_t column = 0; column < columns; column++)
+        {
+            mismatches |= cells[column + 1] ^ is_passable_terrain[terrains[column]];
+        }
+    }
+    if(mismatches != 0)
+    {
+        return report("passability section does not match the terrain");
+    }
+    std::vector<std::uint8_t> row_masks(columns);
+    std::uint8_t* const expected_masks = row_masks.data();
+    for(std::uint64_t row = 0; row < rows; row++)
+    {
+        std::fill(row_masks.begin(), row_masks.end(), 0);
+        for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+        {
+            const Coordinate& direction = eight_principle_directions[i];
+            const std::uint8_t* const neighbors = is_passable + (row + 1 + direction.GetRow()) * padded_columns + 1 + direction.GetColumn();
+            for(std::uint64_t column = 0; column < columns; column++)
+            {
+                expected_masks[column] |= neighbors[column] << i;
+            }
+        }
+        const std::uint8_t* const masks = neighbor_masks + row * columns;
+        for(std::uint64_t column = 0; column < columns; column++)
+        {
+            mismatches |= masks[column] ^ expected_masks[column];
+        }
+    }
+    if(mismatches != 0)
+    {
+        return report("neighbor mask section does not match the passability");
+    }
+    // passable cells are labeled, and cells joined by a move share their label
+    for(std::uint64_t row = 0; row < rows; row++)
+    {
+        const std::uint8_t* const cells = is_passable + (row + 1) * padded_columns + 1;
+        const std::uint32_t* const components = component_ids + row * columns;
+        for(std::uint64_t column = 0; column < columns; column++)
+        {
+            mismatches |= static_cast<std::uint32_t>((components[column] != 0) != cells[column]) |
+                          static_cast<std::uint32_t>(components[column] > number_of_components);
+        }
+        // neighbors beyond the border are skipped, the masks checked above hold no move towards them
+        const std::uint8_t* const masks = neighbor_masks + row * columns;
+        for(std::size_t i = 0; i < eight_principle_directions.size(); i++)
+        {
+            const Coordinate& direction = eight_principle_directions[i];
+            const std::int64_t neighbor_row = static_cast<std::int64_t>(row) + direction.GetRow();
+            if(neighbor_row < 0 || neighbor_row >= static_cast<std::int64_t>(rows))
+            {
+                continue;
+            }
+            const std::uint32_t* const neighbors = component_ids + neighbor_row * columns + direction.GetColumn();
+            const std::uint64_t first = (direction.GetColumn() < 0) ? 1 : 0;
+            const std::uint64_t last = (direction.GetColumn() > 0) ? columns - 1 : columns;
+            for(std::uint64_t column = first; column < last; column++)
+            {
+                const std::uint32_t is_joined = (masks[column] >> i) & cells[column] & 1;
+                mismatches |= is_joined & static_cast<std::uint32_t>(neighbors[column] != components[column]);
+            }
+        }
+    }
+    if(mismatches != 0)
+    {
+        return report("component section does not match the neighbor masks");
+    }
+
+    SetDimensions(static_cast<int>(rows), static_cast<int>(columns));
+    Grid = grid;
+    PassableBits = passable_bits;
+    NeighborMasks = neighbor_masks;
+    ComponentIds = component_ids;
+    NumberOfComponents = number_of_components;
+    Compiled = std::move(file);
+    grid_t().swap(GridStorage);
+    std::vector<std::uint64_t>().swap(PassableStorage);
+    std::vector<std::uint8_t>().swap(MaskStorage);
+    std::vector<std::uint32_t>().swap(ComponentStorage);
+    SourceChecksum = header.SourceChecksum;
+    Landmarks.fill(LandmarkTable()); // distances of the former grid
+    for(const std::string_view payload : landmark_payloads)
+    {
+        LandmarkTable landmarks;
+        if(landmarks.Load(payload, *this))
+        {
+            SetLandmarks(std::move(landmarks));
+        }
+    }
+    Version++;
+    return true;
+}
+
+int Map::GetNumberOfRows(void) const
+{
+    return NumberOfRows;
+}
+
+int Map::GetNumberOfColumns(void) const
+{
+    return NumberOfColumns;
 }
 
 std::string Map::GetGrid(void) const
@@ -122,16 +773,24 @@ std::string Map::GetGrid(void) const
         ss << i << ((i < 10) ? "   " : (i < 100) ? "  " : " ");
         for(int j = 0; j < NumberOfColumns; j++)
         {
-            ss << Grid[i][j]<< ((j < 100) ? "  " : "   ");
+            ss << Grid[CellIndex(i, j)]<< ((j < 100) ? "  " : "   ");
         }
         ss << '\n';
     }
     return ss.str();
 }
 
-std::string Map::GetGridWithSolution(std::vector<Coordinate>& solution, const Agent& agent)
+std::string Map::GetGridWithSolution(const std::vector<Coordinate>& solution, const Agent& agent) const
 {
-    SetAgent(agent);
+    constexpr unsigned char AGENT_MARKER = 'A';
+    constexpr unsigned char GOAL_MARKER = 'G';
+    // markers are applied to the output only, the terrain itself is never modified
+    auto terrain_of = [&](const Coordinate& coordinate)
+    {
+        return (coordinate == agent.GetGoalCoordinate()) ? GOAL_MARKER :
+               (coordinate == agent.GetStartCoordinate()) ? AGENT_MARKER :
+               Grid[CellIndex(coordinate.GetRow(), coordinate.GetColumn())];
+    };
     std::stringstream ss;
     //print columns number
     ss << "    ";
@@ -150,15 +809,14 @@ std::string Map::GetGridWithSolution(std::vector<Coordinate>& solution, const Ag
             if(std::find(solution.begin(), solution.end(), Coordinate(i, j)) != solution.end())
             {
                 // display solution coordinates with red color
-                ss << "\033[1;91m" << Grid[i][j] << "\033[0m" <<((j < 100) ? "  " : "   ");
+                ss << "\033[1;91m" << terrain_of({i, j}) << "\033[0m" <<((j < 100) ? "  " : "   ");
             }
             else
             {
-                ss << Grid[i][j]<< ((j < 100) ? "  " : "   ");
+                ss << terrain_of({i, j})<< ((j < 100) ? "  " : "   ");
             }
         }
         ss << '\n';
     }
-    RemoveAgent(agent);
     return ss.str();
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "../../include/Common/MappedFile.h"
+#include <utility> // exchange()
+#include <fcntl.h> // open()
+#include <unistd.h> // close()
+#include <sys/mman.h> // mmap(), munmap(), madvise()
+#include <sys/stat.h> // fstat()
+
+MappedFile::MappedFile(): Data(nullptr), Size(0), IsWritable(false) {}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept: Data(std::exchange(other.Data, nullptr)),
+    Size(std::exchange(other.Size, 0)), IsWritable(std::exchange(other.IsWritable, false)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if(this != &other)
+    {
+        Close();
+        Data = std::exchange(other.Data, nullptr);
+        Size = std::exchange(other.Size, 0);
+        IsWritable = std::exchange(other.IsWritable, false);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const char* path, const bool is_writable)
+{
+    Close();
+    const int descriptor = ::open(path, O_RDONLY | O_CLOEXEC);
+    if(descriptor < 0)
+    {
+        return false;
+    }
+    struct stat status;
+    if(::fstat(descriptor, &status) != 0 || !S_ISREG(status.st_mode))
+    {
+        ::close(descriptor);
+        return false;
+    }
+    if(status.st_size > 0)
+    {
+        const int protection = is_writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), protection, MAP_PRIVATE, descriptor, 0);
+        if(data == MAP_FAILED)
+        {
+            ::close(descriptor);
+            return false;
+        }
+        // a read-only file is parsed front to back, a writable one is used in place
+        ::madvise(data, static_cast<std::size_t>(status.st_size), is_writable ? MADV_WILLNEED : MADV_SEQUENTIAL);
+        Data = static_cast<char*>(data);
+        Size = static_cast<std::size_t>(status.st_size);
+    }
+    IsWritable = is_writable;
+    // the mapping stays valid once the descriptor is closed
+    ::close(descriptor);
+    return true;
+}
+
+void MappedFile::Close(void)
+{
+    if(Data != nullptr)
+    {
+        ::munmap(Data, Size);
+    }
+    Data = nullptr;
+    Size = 0;
+    IsWritable = false;
+}
+
+std::string_view MappedFile::GetView(void) const
+{
+    return {Data, Size};
+}
+
+char* MappedFile::GetWritableData(void) const
+{
+    return IsWritable ? Data : nullptr;
+}
@@ -1,113 +1,82 @@
 #include "../../include/Common/Planner.h"
 #include "../../include/Common/Printer.h"
-#include <fstream> // ifstream
+#include "../../include/Common/ThreadPool.h"
+#include "../../include/Common/ScenarioReader.h"
+#include <filesystem> // path
+#include <unordered_set>
 
 Planner::Planner(const char* const map_path, const char* const  scenario_path):
-    CurrentMap(), Agents(), SingleAgentPathFinder(nullptr)
+    CurrentMap(), MapPath(map_path), Agents(), SingleAgentPathFinder(nullptr)
 {
-    std::ifstream scenario_file(scenario_path,std::ios::in);
-    if(!scenario_file || !CurrentMap.Load(map_path))
+    ScenarioReader scenario_reader;
+    Scenario scenario;
+    if(!scenario_reader.Open(scenario_path) || !LoadMap())
     {
         DisplayMessage(Red,"Invalid paths for map or scenarios were supplied!\n");
         exit(EXIT_FAILURE);
     }
-    float version = ParseVersion(scenario_file);
-    LoadAgents(scenario_file, version);
-    scenario_file.close();
-}
-
-inline bool Planner::ValidateVersion(float const version)
-{
-    return version == 0.0 || version == 1.0;
-}
-
-float Planner::ParseVersion(std::ifstream &scenario_file)
-{
-    /*
-     * scenario_file contains rows in the following form:
-     * ver = 1.0 : Bucket  map name  map width  map height  start x-coordinate  start y-coordinate  goal x-coordinate  goal y-coordinate  optimal length
-     * ver = 0.0 : Bucket  map name start x-coordinate  start y-coordinate  goal x-coordinate  goal y-coordinate  optimal length
-     */
-    float version;
-    std::string first;
-    scenario_file >> first;
-
-    // Check if a version number is given
-    if (first != "version")
-    {
-        version = 0.0;
-        scenario_file.seekg(0,std::ios::beg);
-    }
-    else
+    if(!scenario_reader.Load(scenario))
     {
-        scenario_file >> version;
+        DisplayMessage(Red, "Malformed scenario ", scenario_path, '\n');
+        exit(EXIT_FAILURE);
     }
-    if(!ValidateVersion(version))
+    if(!scenario.MapName.empty() && std::filesystem::path(MapPath).filename() != scenario.MapName)
     {
-        DisplayMessage(Red, "Invalid scenario version number is given.\nExpected either 1.0 or 0.0\n");
-        exit(EXIT_FAILURE);
+        DisplayMessage(Yellow, "Scenario ", scenario_path, " was made for map ", scenario.MapName, '\n');
     }
-    return version;
+    Agents = std::move(scenario.Agents);
 }
 
-void Planner::LoadAgents(std::ifstream &scenario_file, float const version)
+bool Planner::LoadMap(void)
 {
-    constexpr size_t NUMBER_OF_BUCKETS = 128;
-    Agents.resize(NUMBER_OF_BUCKETS);
-    size_t agents_length = NUMBER_OF_BUCKETS;
-
-    /*
-     * scenario contains rows in the following form:
-     * ver = 1.0 : Bucket  map name  map width  map height  start x-coordinate  start y-coordinate  goal x-coordinate  goal y-coordinate  optimal length
-     * ver = 0.0 : Bucket  map name start x-coordinate  start y-coordinate  goal x-coordinate  goal y-coordinate  optimal length
-     */
-
-    std::string map_name;
-    int map_width = 0, map_height = 0, start_x_coordinate, start_y_coordinate, goal_x_coordinate, goal_y_coordinate;
-    double optimal_length;
-    size_t bucket, max_bucket_number = 0;
-
-    auto add_agent = [&]()
-    {
-        max_bucket_number = std::max(max_bucket_number, bucket);
-        if(max_bucket_number > agents_length)
-        {
-            Agents.resize(max_bucket_number);
-            agents_length = max_bucket_number;
-        }
-        Agents[bucket].emplace_back(start_x_coordinate, start_y_coordinate, goal_x_coordinate, goal_y_coordinate);
-    };
-
-    // Parse rows in their corresponding format, create agent from each
-    if (version == 0.0)
+    constexpr std::string_view COMPILED_EXTENSION = ".mapc";
+    if(MapPath.size() >= COMPILED_EXTENSION.size() &&
+       MapPath.compare(MapPath.size() - COMPILED_EXTENSION.size(), COMPILED_EXTENSION.size(), COMPILED_EXTENSION) == 0)
     {
-        while(scenario_file>>bucket>>map_name>>start_x_coordinate>>start_y_coordinate>>goal_x_coordinate>>goal_y_coordinate>>optimal_length)
-        {
-            add_agent();
-        }
+        const std::string compiled_path = MapPath;
+        MapPath.pop_back(); // tables are kept next to the source map
+        return CurrentMap.LoadCompiled(compiled_path.c_str());
     }
-    else
+    // a compiled map next to the source is preferred, unless it was compiled from another version of the source
+    const std::string compiled_path = MapPath + 'c';
+    std::error_code error;
+    if(std::filesystem::is_regular_file(compiled_path, error) && CurrentMap.LoadCompiled(compiled_path.c_str(), MapPath.c_str()))
     {
-        while(scenario_file>>bucket>>map_name>>map_width>>map_height>>start_x_coordinate>>start_y_coordinate>>goal_x_coordinate>>goal_y_coordinate>>optimal_length)
-        {
-            add_agent();
-        }
+        return true;
     }
+    return CurrentMap.Load(MapPath.c_str());
 }
 
-inline void Planner::SetAgentOnMap(Agent const& agent)
+bool Planner::SaveCompiledMap(void) const
 {
-    CurrentMap.SetAgent(agent);
+    return CurrentMap.SaveCompiled((MapPath + 'c').c_str());
 }
 
-inline void Planner::RemoveAgentFromMap(Agent const& agent)
+void Planner::SetSingleAgentPathFinder(ISingleAgentPathFinder* planner) 
 {
-    CurrentMap.RemoveAgent(agent);
+    SingleAgentPathFinder = planner;
 }
 
-void Planner::SetSingleAgentPathFinder(ISingleAgentPathFinder* planner) 
+void Planner::PrepareDifferentialHeuristic(const Weight weight, const std::size_t number_of_landmarks)
 {
-    SingleAgentPathFinder = planner;
+    const LandmarkTable& current = CurrentMap.GetLandmarks(weight);
+    if(!current.IsEmpty() && current.GetNumberOfLandmarks() == number_of_landmarks)
+    {
+        return; // came with a compiled map
+    }
+    const std::string table_path = MapPath + ((weight == OctileWeight) ? ".octile" : ".unit") + ".landmarks";
+    LandmarkTable landmarks;
+    // a missing table, a table of an outdated map or of a different number of landmarks is rebuilt
+    if(!landmarks.Load(table_path.c_str(), CurrentMap) || landmarks.GetWeight() != weight ||
+       landmarks.GetNumberOfLandmarks() != number_of_landmarks)
+    {
+        landmarks.Build(CurrentMap, number_of_landmarks, weight);
+        if(!landmarks.Save(table_path.c_str()))
+        {
+            DisplayMessage(Yellow, "Failed to save landmarks table to ", table_path, '\n');
+        }
+    }
+    CurrentMap.SetLandmarks(std::move(landmarks));
 }
 
 Report Planner::Plan(const Agent& agent)
@@ -118,40 +87,127 @@ Report Planner::Plan(const Agent& agent)
         return {};
     }
     SingleAgentPathFinder->SetMap(&CurrentMap);
+    return SingleAgentPathFinder->SolveFullReport(agent);
+}
 
-    SetAgentOnMap(agent);
-    auto report =  SingleAgentPathFinder->SolveFullReport(agent);
-    RemoveAgentFromMap(agent);
-    return report;
+void Planner::DisplayOutcome(Report& report, int& number_of_success_planning, int& number_of_failed_planning)
+{
+    constexpr int PATH = 0, AGENT = 1;
+    if(get<PATH>(report).empty()) // no solution is found
+    {
+        number_of_failed_planning++;
+    }
+    else
+    {
+        number_of_success_planning++;
+    }
+    DisplayReport(report);
+    DisplayMessage(CurrentMap.GetGridWithSolution(get<PATH>(report), get<AGENT>(report)));
 }
 
 void Planner::PlanAllScenarios(void)
 {
-    int bucket_number = 0, agent_number;
     int number_of_success_planning = 0, number_of_failed_planning = 0;
-    constexpr int PATH = 0, AGENT = 1;
 
     for(auto const& agents : Agents)
     {
-        agent_number = 0;
         for(auto const& agent : agents)
         {
             Report report = Plan(agent);
-            if(get<0>(report).empty()) // no solution is found
+            DisplayOutcome(report, number_of_success_planning, number_of_failed_planning);
+        }
+    }
+    DisplayMessage(Blue, "Succeeded planning: ", number_of_success_planning, " Failed planning: ", number_of_failed_planning);
+}
+
+std::vector<std::vector<Report>> Planner::PlanAllAgents(const SolverFactory& make_solver, const std::size_t number_of_threads)
+{
+    /*
+     * Every agent is a task of a work-stealing pool, since the cost of a query varies greatly between buckets.
+     * Each worker queries its own solver, hence search state is never shared, while the map is only read.
+     * reports[i][j] is the report of Agents[i][j], regardless of the order in which tasks were completed.
+     */
+    ThreadPool pool(number_of_threads);
+    std::vector<std::unique_ptr<ISingleAgentPathFinder>> solvers(pool.GetNumberOfWorkers());
+    for(auto& solver : solvers)
+    {
+        solver = make_solver();
+        solver->SetMap(&CurrentMap);
+    }
+
+    std::vector<std::vector<Report>> reports(Agents.size());
+    for(std::size_t bucket = 0; bucket < Agents.size(); bucket++)
+    {
+        reports[bucket].resize(Agents[bucket].size());
+        for(std::size_t agent = 0; agent < Agents[bucket].size(); agent++)
+        {
+            pool.Submit([this, &solvers, &reports, bucket, agent](const std::size_t worker)
+            {
+                reports[bucket][agent] = solvers[worker]->SolveFullReport(Agents[bucket][agent]);
+            });
+        }
+    }
+    pool.Wait();
+    return reports;
+}
+
+void Planner::PlanAllScenarios(const SolverFactory& make_solver, const std::size_t number_of_threads)
+{
+    int number_of_success_planning = 0, number_of_failed_planning = 0;
+
+    std::vector<std::vector<Report>> reports = PlanAllAgents(make_solver, number_of_threads);
+    for(auto& bucket_reports : reports)
+    {
+        for(auto& report : bucket_reports)
+        {
+            DisplayOutcome(report, number_of_success_planning, number_of_failed_planning);
+        }
+    }
+    DisplayMessage(Blue, "Succeeded planning: ", number_of_success_planning, " Failed planning: ", number_of_failed_planning);
+}
+
+std::vector<Agent> Planner::SelectAgents(const std::size_t number_of_agents) const
+{
+    std::vector<Agent> selected_agents;
+    std::unordered_set<Coordinate, CoordinateHasher> starts, goals;
+    for(const auto& agents : Agents)
+    {
+        for(const auto& agent : agents)
+        {
+            if(selected_agents.size() == number_of_agents)
             {
-                number_of_failed_planning++;
+                return selected_agents;
             }
-            else
+            if(!starts.contains(agent.GetStartCoordinate()) && !goals.contains(agent.GetGoalCoordinate()))
             {
-                number_of_success_planning++;
+                starts.insert(agent.GetStartCoordinate());
+                goals.insert(agent.GetGoalCoordinate());
+                selected_agents.push_back(agent);
             }
-            DisplayReport(report);
-            DisplayMessage(CurrentMap.GetGridWithSolution(get<PATH>(report), get<AGENT>(report)));
-            agent_number++;
         }
-        bucket_number++;
     }
-    DisplayMessage(Blue, "Succeeded planning: ", number_of_success_planning, " Failed planning: ", number_of_failed_planning);
+    return selected_agents;
+}
+
+void Planner::DisplayOutcome(MultiAgentReport& report)
+{
+    constexpr int PATHS = 0, AGENTS = 1;
+    DisplayMultiAgentReport(report);
+    const Paths& paths = get<PATHS>(report);
+    const std::vector<Agent>& agents = get<AGENTS>(report);
+    for(std::size_t agent = 0; agent < paths.size(); agent++)
+    {
+        DisplayPath(*paths[agent], agent);
+        DisplayMessage(CurrentMap.GetGridWithSolution(*paths[agent], agents[agent]));
+    }
+}
+
+MultiAgentReport Planner::PlanTogether(IMultiAgentPathFinder& path_finder, const std::size_t number_of_agents)
+{
+    path_finder.SetMap(&CurrentMap);
+    MultiAgentReport report = path_finder.SolveFullReport(SelectAgents(number_of_agents));
+    DisplayOutcome(report);
+    return report;
 }
 
 const std::vector<std::vector<Agent>>& Planner::GetAgents(void) const
@@ -159,7 +215,7 @@ const std::vector<std::vector<Agent>>& Planner::GetAgents(void) const
     return Agents;
 }
 
-Map& Planner::GetMap(void)
+const Map& Planner::GetMap(void) const
 {
     return CurrentMap;
 }
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include "../../include/Common/ScenarioReader.h"
+#include "../../include/Common/Printer.h"
+#include "../../include/Common/ThreadPool.h"
+#include <charconv> // from_chars()
+#include <algorithm> // sort(), min(), max()
+#include <filesystem> // directory_iterator
+
+static inline bool IsBlank(const char character)
+{
+    return character == ' ' || character == '\t';
+}
+
+static inline void SkipBlanks(const char*& first, const char* last)
+{
+    while(first != last && IsBlank(*first))
+    {
+        first++;
+    }
+}
+
+// parse the next field of a row as a number, the field must end at a blank or at the end of the row
+template<typename T>
+static inline bool ParseField(const char*& first, const char* last, T& value)
+{
+    SkipBlanks(first, last);
+    const auto [end, error] = std::from_chars(first, last, value);
+    if(error != std::errc() || (end != last && !IsBlank(*end)))
+    {
+        return false;
+    }
+    first = end;
+    return true;
+}
+
+static inline bool ParseField(const char*& first, const char* last, std::string_view& value)
+{
+    SkipBlanks(first, last);
+    const char* end = first;
+    while(end != last && !IsBlank(*end))
+    {
+        end++;
+    }
+    value = std::string_view(first, end - first);
+    first = end;
+    return !value.empty();
+}
+
+ScenarioReader::Iterator::Iterator(): Reader(nullptr), Position(0), LineNumber(0), Entry() {}
+
+ScenarioReader::Iterator::Iterator(const ScenarioReader* reader): Reader(reader), Position(0),
+    LineNumber(reader->FirstRowLine), Entry()
+{
+    Reader->HasError = false;
+    Advance();
+}
+
+void ScenarioReader::Iterator::Advance(void)
+{
+    const std::string_view rows = Reader->Rows;
+    while(Position < rows.size())
+    {
+        const std::size_t line_end = std::min(rows.find('\n', Position), rows.size());
+        const char* first = rows.data() + Position;
+        const char* last = rows.data() + line_end;
+        Position = line_end + 1;
+        LineNumber++;
+        if(last != first && *(last - 1) == '\r')
+        {
+            last--;
+        }
+        SkipBlanks(first, last);
+        if(first == last)
+        {
+            continue;
+        }
+
+        // x-coordinate is the column and y-coordinate is the row of a cell
+        int start_x_coordinate = 0, start_y_coordinate = 0, goal_x_coordinate = 0, goal_y_coordinate = 0;
+        double optimal_length = 0;
+        Entry.MapWidth = Entry.MapHeight = 0;
+        const bool is_parsed = ParseField(first, last, Entry.Bucket) && ParseField(first, last, Entry.MapName) &&
+                               (Reader->Version == 0.0 ||
+                                (ParseField(first, last, Entry.MapWidth) && ParseField(first, last, Entry.MapHeight))) &&
+                               ParseField(first, last, start_x_coordinate) && ParseField(first, last, start_y_coordinate) &&
+                               ParseField(first, last, goal_x_coordinate) && ParseField(first, last, goal_y_coordinate) &&
+                               ParseField(first, last, optimal_length);
+        SkipBlanks(first, last);
+        if(!is_parsed || first != last)
+        {
+            DisplayMessage(Red, "ScenarioReader: ", Reader->Path, ':', LineNumber, ": malformed row of a version ",
+                           Reader->Version, " scenario\n");
+            Reader->HasError = true;
+            Reader = nullptr;
+            return;
+        }
+        Entry.Task = Agent(start_y_coordinate, start_x_coordinate, goal_y_coordinate, goal_x_coordinate, optimal_length);
+        return;
+    }
+    Reader = nullptr;
+}
+
+ScenarioReader::ScenarioReader(): File(), Path(), Version(0), Rows(), FirstRowLine(0), HasError(false) {}
+
+bool ScenarioReader::ParseVersion(std::string_view& content)
+{
+    // a version line is optional, scenarios without it are of version 0.0
+    constexpr std::string_view VERSION = "version";
+    if(content.substr(0, VERSION.size()) != VERSION)
+    {
+        Version = 0.0;
+        FirstRowLine = 0;
+        return true;
+    }
+    const std::size_t line_end = std::min(content.find('\n'), content.size());
+    const char* first = content.data() + VERSION.size();
+    const char* last = content.data() + line_end;
+    if(last != first && *(last - 1) == '\r')
+    {
+        last--;
+    }
+    const bool is_parsed = ParseField(first, last, Version);
+    SkipBlanks(first, last);
+    if(!is_parsed || first != last || (Version != 0.0 && Version != 1.0))
+    {
+        DisplayMessage(Red, "Invalid scenario version number is given in ", Path, ".\nExpected either 1.0 or 0.0\n");
+        return false;
+    }
+    content.remove_prefix(std::min(line_end + 1, content.size()));
+    FirstRowLine = 1;
+    return true;
+}
+
+bool ScenarioReader::Open(const char* path)
+{
+    Path = path;
+    Rows = {};
+    HasError = false;
+    if(!File.Open(path))
+    {
+        DisplayMessage(Red, __PRETTY_FUNCTION__, ": cannot open ", path, '\n');
+        return false;
+    }
+    std::string_view content = File.GetView();
+    if(!ParseVersion(content))
+    {
+        return false;
+    }
+    Rows = content;
+    return true;
+}
+
+float ScenarioReader::GetVersion(void) const
+{
+    return Version;
+}
+
+bool ScenarioReader::Failed(void) const
+{
+    return HasError;
+}
+
+ScenarioReader::Iterator ScenarioReader::begin(void) const
+{
+    return Iterator(this);
+}
+
+ScenarioReader::Iterator ScenarioReader::end(void) const
+{
+    return Iterator();
+}
+
+bool ScenarioReader::Load(Scenario& scenario) const
+{
+    scenario.Path = Path;
+    scenario.MapName.clear();
+    scenario.Agents.clear();
+    for(const ScenarioEntry& entry : *this)
+    {
+        if(scenario.MapName.empty())
+        {
+            scenario.MapName = entry.MapName;
+        }
+        if(entry.Bucket >= scenario.Agents.size())
+        {
+            scenario.Agents.resize(entry.Bucket + 1);
+        }
+        scenario.Agents[entry.Bucket].push_back(entry.Task);
+    }
+    return !HasError;
+}
+
+std::vector<Scenario> ScenarioReader::LoadDirectory(const char* directory, const std::size_t number_of_threads)
+{
+    std::vector<std::string> paths;
+    std::error_code error;
+    for(const auto& file : std::filesystem::directory_iterator(directory, error))
+    {
+        if(file.is_regular_file() && file.path().extension() == ".scen")
+        {
+            paths.push_back(file.path().string());
+        }
+    }
+    if(error)
+    {
+        DisplayMessage(Red, __PRETTY_FUNCTION__, ": cannot read directory ", directory, '\n');
+        return {};
+    }
+    std::sort(paths.begin(), paths.end());
+
+    std::vector<Scenario> scenarios(paths.size());
+    std::vector<char> is_loaded(paths.size(), false);
+    {
+        ThreadPool pool(std::max<std::size_t>(std::min(number_of_threads, paths.size()), 1));
+        for(std::size_t i = 0; i < paths.size(); i++)
+        {
+            pool.Submit([&paths, &scenarios, &is_loaded, i](const std::size_t)
+            {
+                ScenarioReader reader;
+                is_loaded[i] = reader.Open(paths[i].c_str()) && reader.Load(scenarios[i]);
+            });
+        }
+        pool.Wait();
+    }
+
+    std::size_t number_of_loaded = 0;
+    for(std::size_t i = 0; i < scenarios.size(); i++)
+    {
+        if(is_loaded[i] && number_of_loaded++ != i)
+        {
+            scenarios[number_of_loaded - 1] = std::move(scenarios[i]);
+        }
+    }
+    scenarios.resize(number_of_loaded);
+    return scenarios;
+}
@@ -0,0 +1,109 @@
+#include "../../include/Common/ThreadPool.h"
+#include <algorithm> // max()
+
+ThreadPool::ThreadPool(const std::size_t number_of_workers):
+    Queues(std::max<std::size_t>(number_of_workers, 1)), Workers(), Mutex(), HasWork(), IsIdle(),
+    NumberOfQueuedTasks(0), NumberOfPendingTasks(0), NextQueue(0), Stop(false)
+{
+    Workers.reserve(Queues.size());
+    for(std::size_t worker = 0; worker < Queues.size(); worker++)
+    {
+        Workers.emplace_back(&ThreadPool::Run, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        Stop = true;
+    }
+    HasWork.notify_all();
+    for(std::thread& worker : Workers)
+    {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::GetNumberOfWorkers(void) const
+{
+    return Workers.size();
+}
+
+void ThreadPool::Submit(Task task)
+{
+    Queue& queue = Queues[NextQueue];
+    NextQueue = (NextQueue + 1) % Queues.size();
+    NumberOfPendingTasks++;
+    {
+        // counting under Mutex prevents a worker from missing the notification between its check and its wait.
+        // the count precedes the push, hence it never drops below zero when the task is taken right away.
+        std::lock_guard<std::mutex> lock(Mutex);
+        NumberOfQueuedTasks++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue.Mutex);
+        queue.Tasks.push_back(std::move(task));
+    }
+    HasWork.notify_one();
+}
+
+void ThreadPool::Wait(void)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    IsIdle.wait(lock, [this]{ return NumberOfPendingTasks == 0; });
+}
+
+bool ThreadPool::TryPop(const std::size_t worker, Task& task)
+{
+    {
+        // newest task of the worker's own deque
+        Queue& own = Queues[worker];
+        std::lock_guard<std::mutex> lock(own.Mutex);
+        if(!own.Tasks.empty())
+        {
+            task = std::move(own.Tasks.back());
+            own.Tasks.pop_back();
+            return true;
+        }
+    }
+    for(std::size_t offset = 1; offset < Queues.size(); offset++)
+    {
+        // oldest task of a victim deque
+        Queue& victim = Queues[(worker + offset) % Queues.size()];
+        std::lock_guard<std::mutex> lock(victim.Mutex);
+        if(!victim.Tasks.empty())
+        {
+            task = std::move(victim.Tasks.front());
+            victim.Tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::Run(const std::size_t worker)
+{
+    Task task;
+    while(true)
+    {
+        if(TryPop(worker, task))
+        {
+            NumberOfQueuedTasks--;
+            task(worker);
+            task = nullptr;
+            if(--NumberOfPendingTasks == 0)
+            {
+                std::lock_guard<std::mutex> lock(Mutex);
+                IsIdle.notify_all();
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(Mutex);
+        HasWork.wait(lock, [this]{ return Stop || NumberOfQueuedTasks > 0; });
+        if(Stop && NumberOfQueuedTasks == 0)
+        {
+            return;
+        }
+    }
+}
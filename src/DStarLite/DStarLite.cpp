@@ -0,0 +1,361 @@
+#include "../../include/DStarLite/DStarLite.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Agent.h"
+#include "../../include/Common/Printer.h"
+#include "../../include/Common/Directions.h"
+#include <bit> // countr_zero()
+#include <limits>
+#include <algorithm> // min(), max()
+
+const double INFINITE_COST = std::numeric_limits<double>::infinity();
+
+DStarLite::DStarLite(const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(heuristic, weight), Lookup(),
+    OpenSet(), ObservedMap(nullptr), MapVersion(0), ChangedCells(), Start(), Goal(), IsInitialized(false),
+    InitializedHeuristic(heuristic), InitializedWeight(weight), KeyModifier(0), IsRepairing(false), CurrentQuery(0),
+    NumberOfRepairedNodes(0) {}
+
+DStarLite::DStarLite(const Map* map, const Heuristic heuristic, const Weight weight):
+    ISingleAgentPathFinder(map, heuristic, weight), Lookup(), OpenSet(), ObservedMap(nullptr), MapVersion(0),
+    ChangedCells(), Start(), Goal(), IsInitialized(false), InitializedHeuristic(heuristic), InitializedWeight(weight),
+    KeyModifier(0), IsRepairing(false), CurrentQuery(0), NumberOfRepairedNodes(0) {}
+
+DStarLite::DStarLite(const Map* map, const HeuristicFunction& heuristic, const WeightFunction& weight, const CostStructure costs):
+    ISingleAgentPathFinder(map, heuristic, weight, costs), Lookup(), OpenSet(), ObservedMap(nullptr), MapVersion(0),
+    ChangedCells(), Start(), Goal(), IsInitialized(false), InitializedHeuristic(NHeuristic), InitializedWeight(NWeight),
+    KeyModifier(0), IsRepairing(false), CurrentQuery(0), NumberOfRepairedNodes(0) {}
+
+DStarLite::~DStarLite()
+{
+    if(ObservedMap != nullptr)
+    {
+        ObservedMap->RemoveObserver(this);
+    }
+}
+
+void DStarLite::OnPassabilityChanged(const Map& map, const Coordinate& coordinate)
+{
+    // a version skipped without notice, e.g. by reloading the map, leaves MapVersion behind and forces a new search
+    if(&map == ObservedMap && map.GetVersion() == MapVersion + 1)
+    {
+        ChangedCells.push_back(coordinate);
+        MapVersion = map.GetVersion();
+    }
+}
+
+void DStarLite::Reset(void)
+{
+    IsInitialized = false;
+}
+
+DStarLiteNode& DStarLite::GetNode(const Coordinate& coordinate)
+{
+    DStarLiteNode* node = Lookup.Find(coordinate);
+    if(node == nullptr)
+    {
+        node = &Lookup[coordinate];
+        node->MyCoordinate = coordinate;
+    }
+    return *node;
+}
+
+inline void DStarLite::Touch(DStarLiteNode& node)
+{
+    if(IsRepairing && node.RepairStamp != CurrentQuery)
+    {
+        node.RepairStamp = CurrentQuery;
+        NumberOfRepairedNodes++;
+    }
+}
+
+template<typename Visit>
+inline void DStarLite::ForEachNeighbor(const Coordinate& coordinate, Visit&& visit) const
+{
+    // moves lead between passable cells only, and are reversible, hence successors and predecessors coincide
+    if(!CurrentMap->IsPassableCoordinate(coordinate))
+    {
+        return;
+    }
+    for(unsigned int directions = CurrentMap->GetNeighborMask(coordinate); directions != 0; directions &= directions - 1)
+    {
+        const Coordinate& direction = eight_principle_directions[std::countr_zero(directions)];
+        visit(Coordinate(coordinate.GetRow() + direction.GetRow(), coordinate.GetColumn() + direction.GetColumn()));
+    }
+}
+
+template<typename Model>
+inline DStarLiteNode::Key DStarLite::CalculateKey(const DStarLiteNode& node, const Model& model) const
+{
+    const double cost = std::min(node.SumOfWeights, node.Lookahead);
+    return {cost + model.H(node.MyCoordinate, Start) + KeyModifier, cost};
+}
+
+template<typename Model>
+double DStarLite::BestLookahead(const Coordinate& coordinate, const Model& model)
+{
+    double best_lookahead = INFINITE_COST;
+    ForEachNeighbor(coordinate, [&](const Coordinate& successor)
+    {
+        const DStarLiteNode* successor_node = Lookup.Find(successor);
+        if(successor_node != nullptr)
+        {
+            best_lookahead = std::min(best_lookahead, model.W(coordinate, successor) + successor_node->SumOfWeights);
+        }
+    });
+    return best_lookahead;
+}
+
+template<typename Model>
+void DStarLite::UpdateVertex(DStarLiteNode& node, const Model& model)
+{
+    if(node.SumOfWeights != node.Lookahead)
+    {
+        node.Priority = CalculateKey(node, model);
+        if(node.IsQueued)
+        {
+            OpenSet.update(&node);
+        }
+        else
+        {
+            NumberOfGeneratedNodes++;
+            node.IsQueued = true;
+            OpenSet.push(&node);
+        }
+    }
+    else if(node.IsQueued)
+    {
+        node.IsQueued = false;
+        OpenSet.erase(&node);
+    }
+}
+
+template<typename Model>
+void DStarLite::UpdateLookahead(const Coordinate& coordinate, const Model& model)
+{
+    if(coordinate == Goal)
+    {
+        return; // its rhs-value is 0 by definition
+    }
+    DStarLiteNode& node = GetNode(coordinate);
+    const double lookahead = BestLookahead(coordinate, model);
+    if(lookahead != node.Lookahead)
+    {
+        Touch(node);
+        node.Lookahead = lookahead;
+    }
+    UpdateVertex(node, model);
+}
+
+template<typename Model>
+void DStarLite::Initialize(const Model& model)
+{
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+    OpenSet.clear();
+    ChangedCells.clear();
+    KeyModifier = 0;
+    MapVersion = CurrentMap->GetVersion();
+    InitializedHeuristic = IsCustomHeuristic ? NHeuristic : HeuristicType;
+    InitializedWeight = IsCustomWeight ? NWeight : WeightType;
+    IsInitialized = true;
+
+    DStarLiteNode& goal_node = GetNode(Goal);
+    goal_node.Lookahead = 0;
+    UpdateVertex(goal_node, model);
+}
+
+template<typename Model>
+void DStarLite::Repair(const Model& model)
+{
+    // a changed cell alters the moves into and out of it, hence its own rhs-value and the ones of its neighbors
+    for(const Coordinate& coordinate : ChangedCells)
+    {
+        UpdateLookahead(coordinate, model);
+        for(const Coordinate& direction : eight_principle_directions)
+        {
+            const Coordinate neighbor = {coordinate.GetRow() + direction.GetRow(), coordinate.GetColumn() + direction.GetColumn()};
+            if(CurrentMap->IsValidCoordinate(neighbor))
+            {
+                UpdateLookahead(neighbor, model);
+            }
+        }
+    }
+    ChangedCells.clear();
+}
+
+template<typename Model>
+bool DStarLite::ComputeShortestPath(const Model& model)
+{
+    DStarLiteNode& start_node = GetNode(Start);
+    while(!OpenSet.empty() && (IsLessKey(OpenSet.top()->Priority, CalculateKey(start_node, model)) ||
+                               start_node.Lookahead > start_node.SumOfWeights))
+    {
+        DStarLiteNode* curr = OpenSet.top();
+        MaxHeapSize = std::max(OpenSet.size(), MaxHeapSize);
+        NumberOfPopOperations++;
+
+        // the key of a node queued before the start moved may be outdated
+        const DStarLiteNode::Key key = CalculateKey(*curr, model);
+        if(IsLessKey(curr->Priority, key))
+        {
+            curr->Priority = key;
+            OpenSet.update(curr);
+            continue;
+        }
+
+        NumberOfExpandedNodes++;
+        const Coordinate& coordinate = curr->MyCoordinate;
+        if(curr->SumOfWeights > curr->Lookahead)
+        {
+            // overconsistent, its cost to the goal has decreased
+            Touch(*curr);
+            curr->SumOfWeights = curr->Lookahead;
+            curr->IsQueued = false;
+            OpenSet.pop();
+            ForEachNeighbor(coordinate, [&](const Coordinate& predecessor)
+            {
+                if(predecessor == Goal)
+                {
+                    return;
+                }
+                DStarLiteNode& predecessor_node = GetNode(predecessor);
+                const double lookahead = model.W(predecessor, coordinate) + curr->SumOfWeights;
+                if(lookahead < predecessor_node.Lookahead)
+                {
+                    Touch(predecessor_node);
+                    predecessor_node.Lookahead = lookahead;
+                }
+                UpdateVertex(predecessor_node, model);
+            });
+        }
+        else
+        {
+            // underconsistent, its cost to the goal has increased. predecessors which relied on it look for another successor
+            const double former_sum_of_weights = curr->SumOfWeights;
+            Touch(*curr);
+            curr->SumOfWeights = INFINITE_COST;
+            ForEachNeighbor(coordinate, [&](const Coordinate& predecessor)
+            {
+                const DStarLiteNode* predecessor_node = Lookup.Find(predecessor);
+                if(predecessor_node != nullptr &&
+                   predecessor_node->Lookahead == model.W(predecessor, coordinate) + former_sum_of_weights)
+                {
+                    UpdateLookahead(predecessor, model);
+                }
+            });
+            UpdateLookahead(coordinate, model);
+            if(coordinate == Goal)
+            {
+                UpdateVertex(*curr, model);
+            }
+        }
+    }
+    return start_node.Lookahead != INFINITE_COST;
+}
+
+template<typename Model>
+Path DStarLite::ReconstructPath(const Model& model)
+{
+    // descend the g-values from the start, each step takes the successor of the cheapest path to the goal
+    Path solution = {Start};
+    const std::size_t number_of_cells = static_cast<std::size_t>(CurrentMap->GetNumberOfRows()) * CurrentMap->GetNumberOfColumns();
+    Coordinate current = Start;
+    while(current != Goal)
+    {
+        double best_cost = INFINITE_COST;
+        Coordinate best_successor = current;
+        ForEachNeighbor(current, [&](const Coordinate& successor)
+        {
+            const DStarLiteNode* successor_node = Lookup.Find(successor);
+            if(successor_node != nullptr && model.W(current, successor) + successor_node->SumOfWeights < best_cost)
+            {
+                best_cost = model.W(current, successor) + successor_node->SumOfWeights;
+                best_successor = successor;
+            }
+        });
+        if(best_cost == INFINITE_COST || solution.size() > number_of_cells)
+        {
+            return {};
+        }
+        current = best_successor;
+        solution.push_back(current);
+    }
+    return solution;
+}
+
+bool DStarLite::IsOutdated(const Agent& agent) const
+{
+    const Heuristic heuristic = IsCustomHeuristic ? NHeuristic : HeuristicType;
+    const Weight weight = IsCustomWeight ? NWeight : WeightType;
+    return !IsInitialized || agent.GetGoalCoordinate() != Goal || MapVersion != CurrentMap->GetVersion() ||
+           heuristic != InitializedHeuristic || weight != InitializedWeight;
+}
+
+template<typename Model>
+Path DStarLite::Search(const Agent& agent, const Model& model)
+{
+    const Coordinate start = agent.GetStartCoordinate();
+    if(IsOutdated(agent))
+    {
+        IsRepairing = false;
+        Start = start;
+        Goal = agent.GetGoalCoordinate();
+        Initialize(model);
+    }
+    else
+    {
+        // the agent moved, every key is lowered by the estimation between the former start and the new one
+        IsRepairing = true;
+        KeyModifier += model.H(Start, start);
+        Start = start;
+        Repair(model);
+    }
+
+    if(!CurrentMap->IsPassableCoordinate(Start) || !CurrentMap->IsPassableCoordinate(Goal))
+    {
+        return {};
+    }
+    if(Start == Goal)
+    {
+        return {Start};
+    }
+    return ComputeShortestPath(model) ? ReconstructPath(model) : Path();
+}
+
+bool DStarLite::Observe(void)
+{
+    if(CurrentMap == nullptr)
+    {
+        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nullptr!\n");
+        return false;
+    }
+    if(CurrentMap != ObservedMap)
+    {
+        if(ObservedMap != nullptr)
+        {
+            ObservedMap->RemoveObserver(this);
+        }
+        CurrentMap->AddObserver(this);
+        ObservedMap = CurrentMap;
+        IsInitialized = false;
+    }
+    return true;
+}
+
+Path DStarLite::Solve(const Agent& agent)
+{
+    return std::get<0>(SolveFullReport(agent));
+}
+
+Report DStarLite::SolveFullReport(const Agent& agent)
+{
+    if(!Observe() || !IsValidQuery(__PRETTY_FUNCTION__, agent, true))
+    {
+        return {};
+    }
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+    NumberOfRepairedNodes = 0;
+    CurrentQuery++;
+    Path path = WithCostModel([&](const auto& model){ return Search(agent, model); });
+    PeakMemory = Lookup.GetMemoryUsage() + MaxHeapSize * sizeof(DStarLiteNode*);
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory,
+            NumberOfRepairedNodes, path.empty() ? 0.0 : 1.0};
+}
@@ -0,0 +1,33 @@
+#include "../../include/DStarLite/DStarLiteNode.h"
+#include <limits>
+#include <cmath> // abs(), isinf()
+#include <algorithm> // max()
+
+const double INFINITE_COST = std::numeric_limits<double>::infinity();
+constexpr double KEY_TOLERANCE = 1e-9;
+
+DStarLiteNode::DStarLiteNode(): MyCoordinate(), SumOfWeights(INFINITE_COST), Lookahead(INFINITE_COST),
+    Priority({INFINITE_COST, INFINITE_COST}), IsQueued(false), RepairStamp(0), HeapIndex(0) {}
+
+DStarLiteNode::DStarLiteNode(const Coordinate& coordinate): MyCoordinate(coordinate), SumOfWeights(INFINITE_COST),
+    Lookahead(INFINITE_COST), Priority({INFINITE_COST, INFINITE_COST}), IsQueued(false), RepairStamp(0), HeapIndex(0) {}
+
+bool DStarLiteNodeComparator::operator()(const DStarLiteNode *n1, const DStarLiteNode *n2) const
+{
+    return IsLessKey(n2->Priority, n1->Priority);
+}
+
+static inline bool IsLess(const double v1, const double v2)
+{
+    const double difference = v2 - v1;
+    return std::isinf(difference) ? (difference > 0) : (difference > KEY_TOLERANCE * std::max(1.0, std::abs(v1)));
+}
+
+bool IsLessKey(const DStarLiteNode::Key& k1, const DStarLiteNode::Key& k2)
+{
+    if(IsLess(k1[0], k2[0]) || IsLess(k2[0], k1[0]))
+    {
+        return IsLess(k1[0], k2[0]);
+    }
+    return IsLess(k1[1], k2[1]);
+}
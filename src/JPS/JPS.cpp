@@ -0,0 +1,319 @@
+#include "../../include/JPS/JPS.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Agent.h"
+#include "../../include/Common/Printer.h"
+#include "../../include/Common/Directions.h"
+#include <cstdlib> // abs()
+#include <algorithm> // min(), max(), reverse()
+#include <bit> // countr_zero()
+
+// index of (row_direction, column_direction) in eight_principle_directions
+static std::size_t DirectionIndex(int const row_direction, int const column_direction)
+{
+    if(column_direction == 0)
+    {
+        return (row_direction > 0) ? 0 : 1;
+    }
+    if(row_direction == 0)
+    {
+        return (column_direction > 0) ? 2 : 3;
+    }
+    if(row_direction > 0)
+    {
+        return (column_direction > 0) ? 4 : 6;
+    }
+    return (column_direction > 0) ? 5 : 7;
+}
+
+static int Sign(int const value)
+{
+    return (value > 0) - (value < 0);
+}
+
+JPS::JPS(const Heuristic heuristic): ISingleAgentPathFinder(heuristic, OctileWeight), Lookup(),
+    OpenList(AutomaticOpenList), Jumps() {}
+
+JPS::JPS(const Map* map, const Heuristic heuristic): ISingleAgentPathFinder(map, heuristic, OctileWeight), Lookup(),
+    OpenList(AutomaticOpenList), Jumps() {}
+
+void JPS::SetOpenList(const OpenListType open_list)
+{
+    OpenList = open_list;
+}
+
+inline bool JPS::IsPassable(int const row, int const column) const
+{
+    return CurrentMap->IsPassableCoordinate({row, column});
+}
+
+unsigned int JPS::PruneDirections(const CellId cell, const Coordinate& coordinate) const
+{
+    const unsigned int neighbors = CurrentMap->GetNeighborMask(cell);
+    if(Lookup.GetParent(cell) == cell)
+    {
+        return neighbors; // the root has no direction of arrival, none of its neighbors is pruned
+    }
+
+    // natural neighbors continue the move which reached the node, forced neighbors lie behind an adjacent obstacle
+    const Coordinate parent = CurrentMap->GetCoordinate(Lookup.GetParent(cell));
+    const int row = coordinate.GetRow(), column = coordinate.GetColumn();
+    const int row_direction = Sign(row - parent.GetRow());
+    const int column_direction = Sign(column - parent.GetColumn());
+    unsigned int directions = 1u << DirectionIndex(row_direction, column_direction);
+    if(row_direction == 0)
+    {
+        directions |= IsPassable(row - 1, column) ? 0 : 1u << DirectionIndex(-1, column_direction);
+        directions |= IsPassable(row + 1, column) ? 0 : 1u << DirectionIndex(1, column_direction);
+    }
+    else if(column_direction == 0)
+    {
+        directions |= IsPassable(row, column - 1) ? 0 : 1u << DirectionIndex(row_direction, -1);
+        directions |= IsPassable(row, column + 1) ? 0 : 1u << DirectionIndex(row_direction, 1);
+    }
+    else
+    {
+        directions |= 1u << DirectionIndex(row_direction, 0);
+        directions |= 1u << DirectionIndex(0, column_direction);
+        directions |= IsPassable(row - row_direction, column) ? 0 : 1u << DirectionIndex(-row_direction, column_direction);
+        directions |= IsPassable(row, column - column_direction) ? 0 : 1u << DirectionIndex(row_direction, -column_direction);
+    }
+    return directions & neighbors;
+}
+
+bool JPS::JumpStraight(const Coordinate& from, std::size_t const direction_index, const Coordinate& goal,
+                       Coordinate& jump_point) const
+{
+    const Coordinate& direction = eight_principle_directions[direction_index];
+    const int distance = Jumps.GetDistance(from, direction_index);
+    // the goal is a jump point whenever the run passes over it
+    int goal_steps = 0;
+    if(direction.GetRow() == 0 && goal.GetRow() == from.GetRow())
+    {
+        goal_steps = (goal.GetColumn() - from.GetColumn()) * direction.GetColumn();
+    }
+    else if(direction.GetColumn() == 0 && goal.GetColumn() == from.GetColumn())
+    {
+        goal_steps = (goal.GetRow() - from.GetRow()) * direction.GetRow();
+    }
+    if(goal_steps > 0 && goal_steps <= std::abs(distance))
+    {
+        jump_point = goal;
+        return true;
+    }
+    if(distance > 0)
+    {
+        jump_point = {from.GetRow() + distance * direction.GetRow(), from.GetColumn() + distance * direction.GetColumn()};
+        return true;
+    }
+    return false;
+}
+
+bool JPS::Jump(const Coordinate& from, std::size_t const direction_index, const Coordinate& goal, Coordinate& jump_point) const
+{
+    if(direction_index < JumpTable::NUMBER_OF_STRAIGHT_DIRECTIONS)
+    {
+        return JumpStraight(from, direction_index, goal, jump_point);
+    }
+
+    // step diagonally until a cell is a jump point itself, or one of its straight runs reaches a jump point
+    const int row_direction = eight_principle_directions[direction_index].GetRow();
+    const int column_direction = eight_principle_directions[direction_index].GetColumn();
+    const std::size_t vertical = DirectionIndex(row_direction, 0), horizontal = DirectionIndex(0, column_direction);
+    int row = from.GetRow(), column = from.GetColumn();
+    Coordinate straight_jump_point;
+    while(true)
+    {
+        row += row_direction;
+        column += column_direction;
+        if(!IsPassable(row, column))
+        {
+            return false;
+        }
+        const Coordinate current = {row, column};
+        if(current == goal || JumpTable::HasForcedNeighbor(*CurrentMap, row, column, row_direction, column_direction) ||
+           JumpStraight(current, vertical, goal, straight_jump_point) ||
+           JumpStraight(current, horizontal, goal, straight_jump_point))
+        {
+            jump_point = current;
+            return true;
+        }
+    }
+}
+
+template<typename OpenSet, typename Model>
+void JPS::Generate(AStarNode* root_node, const Coordinate& root_coordinate, const CellId successor,
+                   const Coordinate& successor_coordinate, const Coordinate& goal, OpenSet& open_set, const Model& model)
+{
+    // jump points lie on a straight or diagonal line from their parent, at octile distance
+    AStarNode* successor_node = Lookup.Find(successor);
+    const int row_steps = std::abs(successor_coordinate.GetRow() - root_coordinate.GetRow());
+    const int column_steps = std::abs(successor_coordinate.GetColumn() - root_coordinate.GetColumn());
+    const int diagonal_steps = std::min(row_steps, column_steps);
+    double successor_sum_of_weights = root_node->SumOfWeights + (std::max(row_steps, column_steps) - diagonal_steps) +
+                                      SQRT2 * diagonal_steps;
+    double successor_static_value = successor_sum_of_weights + model.H(successor_coordinate, goal);
+
+    if(successor_node != nullptr)
+    {
+        if(successor_node->SumOfWeights > successor_sum_of_weights)
+        {
+            successor_node->SumOfWeights = successor_sum_of_weights;
+            successor_node->StaticValue = successor_static_value;
+            Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+            open_set.decrease(successor_node);
+        }
+    }
+    else
+    {
+        NumberOfGeneratedNodes++;
+        AStarNode& node = Lookup[successor];
+        node = {successor_static_value, successor_sum_of_weights};
+        Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+        open_set.push(&node);
+    }
+}
+
+template<typename OpenSet, typename Model>
+void JPS::Expand(AStarNode* root_node, const Coordinate& goal, OpenSet& open_set, const Model& model)
+{
+    NumberOfExpandedNodes++;
+    // jumps run over coordinates, the nodes of the jump points are addressed by their cell id
+    const CellId root = Lookup.GetCellId(root_node);
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    Coordinate jump_point;
+    for(unsigned int directions = PruneDirections(root, root_coordinate); directions != 0; directions &= directions - 1)
+    {
+        if(Jump(root_coordinate, std::countr_zero(directions), goal, jump_point))
+        {
+            const CellId successor = CurrentMap->GetCellId(jump_point);
+            if(!Lookup.HasStatus(successor, ClosedStatus))
+            {
+                Generate(root_node, root_coordinate, successor, jump_point, goal, open_set, model);
+            }
+        }
+    }
+    Lookup.SetStatus(root, ClosedStatus);
+}
+
+template<typename OpenSet, typename Model>
+bool JPS::Search(const Coordinate root_coordinate, const Coordinate& goal, const Model& model)
+{
+    // the root is its own parent, which marks it as having no direction of arrival
+    OpenSet open_set;
+    const CellId root = CurrentMap->GetCellId(root_coordinate), goal_cell = CurrentMap->GetCellId(goal);
+    AStarNode& root_node = Lookup[root];
+    root_node = {model.H(root_coordinate, goal), 0};
+    Lookup.SetParent(root, root);
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+
+    open_set.push(&root_node);
+    while(!open_set.empty())
+    {
+        AStarNode* curr = open_set.top();
+        MaxHeapSize = std::max(open_set.size(), MaxHeapSize);
+
+        open_set.pop();
+        NumberOfPopOperations++;
+
+        if(Lookup.GetCellId(curr) == goal_cell)
+        {
+            return true;
+        }
+
+        Expand(curr, goal, open_set, model);
+    }
+    return false;
+}
+
+bool JPS::Search(const Coordinate root_coordinate, const Coordinate& goal)
+{
+    const OpenListType open_list = SelectOpenList(OpenList);
+    return WithCostModel([&](const auto& model)
+    {
+        switch(open_list)
+        {
+            case FibonacciHeapOpenList:
+                return Search<fibonacci_heap_t>(root_coordinate, goal, model);
+            case BucketOpenList:
+                return Search<bucket_queue_t>(root_coordinate, goal, model);
+            case IntegralBucketOpenList:
+                return Search<integral_bucket_queue_t>(root_coordinate, goal, model);
+            default:
+                return Search<quaternary_heap_t>(root_coordinate, goal, model);
+        }
+    });
+}
+
+Path JPS::ReconstructPath(const Agent& agent)
+{
+    // walk back over the jump points, filling in the cells of the line between each one and its parent
+    const Coordinate& source = agent.GetStartCoordinate();
+    Coordinate current = agent.GetGoalCoordinate();
+    Path solution;
+
+    while(current != source)
+    {
+        const Coordinate parent = CurrentMap->GetCoordinate(Lookup.GetParent(CurrentMap->GetCellId(current)));
+        const int row_direction = Sign(parent.GetRow() - current.GetRow());
+        const int column_direction = Sign(parent.GetColumn() - current.GetColumn());
+        for(; current != parent; current = {current.GetRow() + row_direction, current.GetColumn() + column_direction})
+        {
+            solution.emplace_back(current);
+        }
+    }
+
+    solution.push_back(source);
+    std::reverse(solution.begin(), solution.end());
+
+    return solution;
+}
+
+bool JPS::Prepare(const Agent& agent)
+{
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
+    {
+        return false;
+    }
+    if(!Jumps.IsBuiltFor(*CurrentMap))
+    {
+        Jumps.Build(*CurrentMap);
+    }
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+    return true;
+}
+
+Path JPS::Solve(const Agent& agent)
+{
+    if(!Prepare(agent))
+    {
+        return {};
+    }
+    const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
+    // a goal outside of the component of the start is rejected without a search
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
+    if(is_solution_found)
+    {
+        return ReconstructPath(agent);
+    }
+    return {};
+}
+
+Report JPS::SolveFullReport(const Agent& agent)
+{
+    if(!Prepare(agent))
+    {
+        return {};
+    }
+    const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
+    Path path;
+    if(is_solution_found)
+    {
+        path = ReconstructPath(agent);
+    }
+    // node slots of the whole grid, and one open-set entry per node at the largest open-set
+    PeakMemory = Lookup.GetMemoryUsage() + MaxHeapSize * sizeof(AStarNode*);
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            path.empty() ? 0.0 : 1.0};
+}
@@ -0,0 +1,80 @@
+#include "../../include/JPS/JumpTable.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Directions.h" // eight_principle_directions
+
+JumpTable::JumpTable(): SourceMap(nullptr), MapVersion(0), NumberOfRows(0), NumberOfColumns(0), Distances() {}
+
+inline std::size_t JumpTable::Index(int const row, int const column, std::size_t const direction) const
+{
+    return (static_cast<std::size_t>(row) * NumberOfColumns + column) * NUMBER_OF_STRAIGHT_DIRECTIONS + direction;
+}
+
+bool JumpTable::HasForcedNeighbor(const Map& map, int const row, int const column, int const row_direction,
+                                  int const column_direction)
+{
+    // cells at most one step outside of the grid are impassable, as the passability bitmap is padded
+    auto is_free = [&](int const r, int const c){ return map.IsPassableCoordinate({r, c}); };
+    if(row_direction == 0)
+    {
+        return (!is_free(row - 1, column) && is_free(row - 1, column + column_direction)) ||
+               (!is_free(row + 1, column) && is_free(row + 1, column + column_direction));
+    }
+    if(column_direction == 0)
+    {
+        return (!is_free(row, column - 1) && is_free(row + row_direction, column - 1)) ||
+               (!is_free(row, column + 1) && is_free(row + row_direction, column + 1));
+    }
+    return (!is_free(row - row_direction, column) && is_free(row - row_direction, column + column_direction)) ||
+           (!is_free(row, column - column_direction) && is_free(row + row_direction, column - column_direction));
+}
+
+void JumpTable::Build(const Map& map)
+{
+    SourceMap = &map;
+    MapVersion = map.GetVersion();
+    NumberOfRows = map.GetNumberOfRows();
+    NumberOfColumns = map.GetNumberOfColumns();
+    Distances.assign(static_cast<std::size_t>(NumberOfRows) * NumberOfColumns * NUMBER_OF_STRAIGHT_DIRECTIONS, 0);
+
+    for(std::size_t direction = 0; direction < NUMBER_OF_STRAIGHT_DIRECTIONS; direction++)
+    {
+        const int row_direction = eight_principle_directions[direction].GetRow();
+        const int column_direction = eight_principle_directions[direction].GetColumn();
+        // visit cells against the direction, so the distance of the next cell is known when a cell is visited
+        for(int i = 0; i < NumberOfRows; i++)
+        {
+            const int row = (row_direction > 0) ? NumberOfRows - 1 - i : i;
+            for(int j = 0; j < NumberOfColumns; j++)
+            {
+                const int column = (column_direction > 0) ? NumberOfColumns - 1 - j : j;
+                const int next_row = row + row_direction, next_column = column + column_direction;
+                int& distance = Distances[Index(row, column, direction)];
+                if(!map.IsPassableCoordinate({next_row, next_column}))
+                {
+                    distance = 0;
+                }
+                else if(HasForcedNeighbor(map, next_row, next_column, row_direction, column_direction))
+                {
+                    distance = 1;
+                }
+                else
+                {
+                    const int next_distance = Distances[Index(next_row, next_column, direction)];
+                    distance = (next_distance > 0) ? next_distance + 1 : next_distance - 1;
+                }
+            }
+        }
+    }
+}
+
+bool JumpTable::IsBuiltFor(const Map& map) const
+{
+    // any change of passability may move jump points, the table is rebuilt as a whole
+    return SourceMap == &map && MapVersion == map.GetVersion() && NumberOfRows == map.GetNumberOfRows() &&
+           NumberOfColumns == map.GetNumberOfColumns();
+}
+
+int JumpTable::GetDistance(const Coordinate& coordinate, std::size_t const direction) const
+{
+    return Distances[Index(coordinate.GetRow(), coordinate.GetColumn(), direction)];
+}
@@ -0,0 +1,257 @@
+#include "../../include/MAPF/CBS.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Printer.h"
+#include <array>
+#include <algorithm> // max()
+
+constexpr std::size_t DEFAULT_NODE_LIMIT = 100000;
+
+CBS::ConstraintList::ConstraintList(const Constraint& value, const std::shared_ptr<ConstraintList>& next):
+    Value(value), Next(next) {}
+
+CBS::ConstraintList::~ConstraintList()
+{
+    // a node no one else refers to is detached from its successor before it is destroyed
+    std::shared_ptr<ConstraintList> next = std::move(Next);
+    while(next != nullptr && next.use_count() == 1)
+    {
+        next = std::move(next->Next);
+    }
+}
+
+CBS::CBS(): IMultiAgentPathFinder(), Workers(), Distances(nullptr), NumberOfThreads(1), NodeLimit(DEFAULT_NODE_LIMIT),
+    Mutex(), HasWork(), OpenSet(), Incumbent(nullptr), NumberOfBusyWorkers(0), IsDone(false) {}
+
+CBS::CBS(const Map* map): IMultiAgentPathFinder(map), Workers(), Distances(nullptr), NumberOfThreads(1),
+    NodeLimit(DEFAULT_NODE_LIMIT), Mutex(), HasWork(), OpenSet(), Incumbent(nullptr), NumberOfBusyWorkers(0),
+    IsDone(false) {}
+
+void CBS::SetDistanceCache(const std::shared_ptr<GoalDistanceCache>& distances)
+{
+    Distances = distances;
+}
+
+void CBS::SetNodeLimit(const std::size_t node_limit)
+{
+    NodeLimit = node_limit;
+}
+
+void CBS::SetNumberOfThreads(const std::size_t number_of_threads)
+{
+    NumberOfThreads = std::max<std::size_t>(number_of_threads, 1);
+}
+
+bool CBS::NodeComparator::operator()(const Node* n1, const Node* n2) const
+{
+    return (n1->Cost == n2->Cost) ? (n1->NumberOfConflicts > n2->NumberOfConflicts) : (n1->Cost > n2->Cost);
+}
+
+bool CBS::Replan(Worker& worker, Node& node, const int agent, const std::vector<Agent>& agents)
+{
+    constexpr int PATH = 0, NEXPANDED = 2;
+    worker.Reservations.Clear(CurrentMap->GetNumberOfColumns());
+    for(const ConstraintList* entry = node.Constraints.get(); entry != nullptr; entry = entry->Next.get())
+    {
+        const Constraint& constraint = entry->Value;
+        if(constraint.Agent != agent)
+        {
+            continue;
+        }
+        if(constraint.From == constraint.To)
+        {
+            worker.Reservations.AddVertexConstraint(constraint.From, constraint.Time);
+        }
+        else
+        {
+            worker.Reservations.AddMoveConstraint(constraint.From, constraint.To, constraint.Time);
+        }
+    }
+
+    Report report = worker.LowLevel.SolveFullReport(agents[agent]);
+    worker.NumberOfLowLevelSearches++;
+    worker.NumberOfLowLevelExpandedNodes += std::get<NEXPANDED>(report);
+    Path& path = std::get<PATH>(report);
+    if(path.empty())
+    {
+        return false;
+    }
+    node.Solution[agent] = std::make_shared<const Path>(std::move(path));
+    return true;
+}
+
+void CBS::Evaluate(Worker& worker, Node& node)
+{
+    node.NumberOfConflicts = worker.Detector.Detect(node.Solution, node.FirstConflict);
+}
+
+CBS::Node* CBS::Branch(Worker& worker, const Node& parent, const Constraint& constraint, const std::vector<Agent>& agents)
+{
+    // the child copies the paths of its parent by reference, only the constrained agent gets a new one
+    Node& child = worker.Tree.emplace_back();
+    child.Constraints = std::make_shared<ConstraintList>(constraint, parent.Constraints);
+    child.Solution = parent.Solution;
+    if(!Replan(worker, child, constraint.Agent, agents))
+    {
+        worker.Tree.pop_back();
+        return nullptr;
+    }
+    child.Cost = parent.Cost - (parent.Solution[constraint.Agent]->size() - 1) + (child.Solution[constraint.Agent]->size() - 1);
+    Evaluate(worker, child);
+    return &child;
+}
+
+CBS::Node* CBS::Pop(void)
+{
+    std::unique_lock<std::mutex> lock(Mutex);
+    while(!IsDone)
+    {
+        const unsigned long incumbent_cost = (Incumbent == nullptr) ? std::numeric_limits<unsigned long>::max() :
+                                             Incumbent->Cost;
+        if(!OpenSet.empty() && OpenSet.top()->Cost < incumbent_cost)
+        {
+            Node* node = OpenSet.top();
+            if(node->NumberOfConflicts > 0)
+            {
+                if(NumberOfExpandedNodes == NodeLimit)
+                {
+                    DisplayMessage(Yellow, "CBS reached its limit of ", NodeLimit, " expanded nodes\n");
+                    break;
+                }
+                NumberOfExpandedNodes++;
+            }
+            OpenSet.pop();
+            NumberOfBusyWorkers++;
+            return node;
+        }
+        // a node being expanded by another thread may still yield a cheaper node
+        if(NumberOfBusyWorkers == 0)
+        {
+            break;
+        }
+        HasWork.wait(lock);
+    }
+    IsDone = true;
+    HasWork.notify_all();
+    return nullptr;
+}
+
+void CBS::Search(Worker& worker, const std::vector<Agent>& agents)
+{
+    while(Node* curr = Pop())
+    {
+        std::array<Node*, 2> children = {nullptr, nullptr};
+        if(curr->NumberOfConflicts > 0)
+        {
+            // a vertex conflict forbids each agent the cell, a swap conflict forbids each agent its move
+            const Conflict& conflict = curr->FirstConflict;
+            const Coordinate& first_target = conflict.IsSwap ? conflict.SecondCell : conflict.FirstCell;
+            const Coordinate& second_target = conflict.IsSwap ? conflict.FirstCell : conflict.SecondCell;
+            children[0] = Branch(worker, *curr, {conflict.FirstAgent, conflict.FirstCell, first_target, conflict.Time}, agents);
+            children[1] = Branch(worker, *curr, {conflict.SecondAgent, conflict.SecondCell, second_target, conflict.Time}, agents);
+            // an expanded node is never visited again, its paths and constraints live on in the children sharing them
+            curr->Constraints.reset();
+            Paths().swap(curr->Solution);
+        }
+
+        std::lock_guard<std::mutex> lock(Mutex);
+        if(curr->NumberOfConflicts == 0 && (Incumbent == nullptr || curr->Cost < Incumbent->Cost))
+        {
+            Incumbent = curr;
+        }
+        for(Node* child : children)
+        {
+            if(child != nullptr)
+            {
+                OpenSet.push(child);
+            }
+        }
+        NumberOfBusyWorkers--;
+        HasWork.notify_all();
+    }
+}
+
+void CBS::PrepareWorkers(void)
+{
+    if(Distances == nullptr || Distances->GetMap() != CurrentMap)
+    {
+        Distances = std::make_shared<GoalDistanceCache>(CurrentMap, UnitWeight);
+    }
+    Workers.resize(NumberOfThreads);
+    for(auto& worker : Workers)
+    {
+        if(worker == nullptr)
+        {
+            worker = std::make_unique<Worker>();
+        }
+        worker->LowLevel.SetMap(CurrentMap);
+        worker->LowLevel.SetDistanceCache(Distances);
+        worker->LowLevel.SetReservationTable(&worker->Reservations);
+        worker->Detector.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+        worker->Tree.clear();
+        worker->NumberOfLowLevelSearches = 0;
+        worker->NumberOfLowLevelExpandedNodes = 0;
+    }
+    OpenSet.clear();
+    Incumbent = nullptr;
+    NumberOfBusyWorkers = 0;
+    IsDone = false;
+}
+
+void CBS::CollectStatistics(void)
+{
+    NumberOfLowLevelSearches = 0;
+    NumberOfLowLevelExpandedNodes = 0;
+    for(const auto& worker : Workers)
+    {
+        NumberOfLowLevelSearches += worker->NumberOfLowLevelSearches;
+        NumberOfLowLevelExpandedNodes += worker->NumberOfLowLevelExpandedNodes;
+    }
+}
+
+Paths CBS::Solve(const std::vector<Agent>& agents)
+{
+    return std::get<0>(SolveFullReport(agents));
+}
+
+MultiAgentReport CBS::SolveFullReport(const std::vector<Agent>& agents)
+{
+    NumberOfExpandedNodes = NumberOfLowLevelSearches = 0;
+    NumberOfLowLevelExpandedNodes = 0;
+    if(!ValidateAgents(agents))
+    {
+        return {Paths(), agents, 0, 0, 0, 0};
+    }
+    PrepareWorkers();
+
+    // the root plans every agent on its own
+    Worker& main_worker = *Workers.front();
+    Node& root = main_worker.Tree.emplace_back();
+    root.Solution.resize(agents.size());
+    for(int agent = 0; agent < static_cast<int>(agents.size()); agent++)
+    {
+        if(!Replan(main_worker, root, agent, agents))
+        {
+            CollectStatistics();
+            return {Paths(), agents, 0, NumberOfExpandedNodes, NumberOfLowLevelSearches, NumberOfLowLevelExpandedNodes};
+        }
+    }
+    root.Cost = GetSumOfCosts(root.Solution);
+    Evaluate(main_worker, root);
+    OpenSet.push(&root);
+
+    std::vector<std::thread> threads;
+    for(std::size_t worker = 1; worker < Workers.size(); worker++)
+    {
+        threads.emplace_back([this, worker, &agents]{ Search(*Workers[worker], agents); });
+    }
+    Search(main_worker, agents);
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    CollectStatistics();
+    Paths paths = (Incumbent == nullptr) ? Paths() : Incumbent->Solution;
+    const unsigned long sum_of_costs = (Incumbent == nullptr) ? 0 : Incumbent->Cost;
+    return {paths, agents, sum_of_costs, NumberOfExpandedNodes, NumberOfLowLevelSearches, NumberOfLowLevelExpandedNodes};
+}
@@ -0,0 +1,90 @@
+#include "../../include/MAPF/Conflict.h"
+#include <algorithm> // max(), min(), fill()
+
+ConflictDetector::ConflictDetector(): NumberOfColumns(0), Occupants(), Stamps(), CurrentStamp(0) {}
+
+void ConflictDetector::Reset(const int rows, const int columns)
+{
+    const std::size_t number_of_cells = static_cast<std::size_t>(rows) * columns;
+    if(columns != NumberOfColumns || number_of_cells != Occupants.size())
+    {
+        NumberOfColumns = columns;
+        Occupants.assign(number_of_cells, -1);
+        Stamps.assign(number_of_cells, 0);
+        CurrentStamp = 0;
+    }
+}
+
+inline std::uint32_t ConflictDetector::CellIndex(const Coordinate& coordinate) const
+{
+    return static_cast<std::uint32_t>(coordinate.GetRow() * NumberOfColumns + coordinate.GetColumn());
+}
+
+inline const Coordinate& ConflictDetector::GetCoordinate(const Path& path, const std::size_t time)
+{
+    return path[std::min(time, path.size() - 1)]; // the agent stays at its goal once its path ends
+}
+
+std::size_t ConflictDetector::Detect(const Paths& paths, Conflict& first_conflict)
+{
+    std::size_t number_of_conflicts = 0, makespan = 0;
+    for(const auto& path : paths)
+    {
+        makespan = std::max(makespan, path->size());
+    }
+
+    auto record = [&](const Conflict& conflict)
+    {
+        if(number_of_conflicts++ == 0)
+        {
+            first_conflict = conflict;
+        }
+    };
+
+    // once every path has ended no agent moves, hence conflicts may occur only before
+    const int number_of_agents = static_cast<int>(paths.size());
+    for(std::size_t time = 0; time < makespan; time++)
+    {
+        if(++CurrentStamp == 0) // wrapped around, stamps of former scans might match again
+        {
+            std::fill(Stamps.begin(), Stamps.end(), 0);
+            CurrentStamp = 1;
+        }
+        for(int agent = 0; agent < number_of_agents; agent++)
+        {
+            const Coordinate& cell = GetCoordinate(*paths[agent], time);
+            const std::uint32_t cell_index = CellIndex(cell);
+            if(Stamps[cell_index] == CurrentStamp)
+            {
+                record({Occupants[cell_index], agent, cell, cell, static_cast<int>(time), false});
+                continue;
+            }
+            Stamps[cell_index] = CurrentStamp;
+            Occupants[cell_index] = agent;
+        }
+        if(time == 0)
+        {
+            continue;
+        }
+        // an agent which moved into the previous cell of another agent, where the other one came from its cell
+        for(int agent = 0; agent < number_of_agents; agent++)
+        {
+            const Coordinate& source = GetCoordinate(*paths[agent], time - 1), target = GetCoordinate(*paths[agent], time);
+            if(source == target)
+            {
+                continue;
+            }
+            const std::uint32_t source_index = CellIndex(source);
+            if(Stamps[source_index] != CurrentStamp)
+            {
+                continue;
+            }
+            const int other_agent = Occupants[source_index];
+            if(other_agent > agent && GetCoordinate(*paths[other_agent], time - 1) == target)
+            {
+                record({agent, other_agent, source, target, static_cast<int>(time) - 1, true});
+            }
+        }
+    }
+    return number_of_conflicts;
+}
@@ -0,0 +1,51 @@
+#include "../../include/MAPF/PrioritizedPlanning.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Printer.h"
+
+PrioritizedPlanning::PrioritizedPlanning(): IMultiAgentPathFinder(), LowLevel(), Reservations() {}
+
+PrioritizedPlanning::PrioritizedPlanning(const Map* map): IMultiAgentPathFinder(map), LowLevel(map), Reservations() {}
+
+void PrioritizedPlanning::SetDistanceCache(const std::shared_ptr<GoalDistanceCache>& distances)
+{
+    LowLevel.SetDistanceCache(distances);
+}
+
+Paths PrioritizedPlanning::Solve(const std::vector<Agent>& agents)
+{
+    return std::get<0>(SolveFullReport(agents));
+}
+
+MultiAgentReport PrioritizedPlanning::SolveFullReport(const std::vector<Agent>& agents)
+{
+    constexpr int PATH = 0, NEXPANDED = 2;
+    NumberOfExpandedNodes = NumberOfLowLevelSearches = 0;
+    NumberOfLowLevelExpandedNodes = 0;
+    if(!ValidateAgents(agents))
+    {
+        return {Paths(), agents, 0, 0, 0, 0};
+    }
+
+    Reservations.Clear(CurrentMap->GetNumberOfColumns());
+    LowLevel.SetMap(CurrentMap);
+    LowLevel.SetReservationTable(&Reservations);
+    Paths paths;
+    paths.reserve(agents.size());
+    for(const Agent& agent : agents)
+    {
+        Report report = LowLevel.SolveFullReport(agent);
+        NumberOfLowLevelSearches++;
+        NumberOfLowLevelExpandedNodes += std::get<NEXPANDED>(report);
+        Path& path = std::get<PATH>(report);
+        if(path.empty())
+        {
+            DisplayMessage(Yellow, "Prioritized planning failed to plan agent number: ", paths.size(), '\n');
+            LowLevel.SetReservationTable(nullptr);
+            return {Paths(), agents, 0, NumberOfExpandedNodes, NumberOfLowLevelSearches, NumberOfLowLevelExpandedNodes};
+        }
+        Reservations.Reserve(path);
+        paths.push_back(std::make_shared<const Path>(std::move(path)));
+    }
+    LowLevel.SetReservationTable(nullptr);
+    return {paths, agents, GetSumOfCosts(paths), NumberOfExpandedNodes, NumberOfLowLevelSearches, NumberOfLowLevelExpandedNodes};
+}
@@ -0,0 +1,114 @@
+#include "../../include/MAPF/ReservationTable.h"
+#include <algorithm> // max()
+
+ReservationTable::ReservationTable(const int number_of_columns): NumberOfColumns(number_of_columns), Vertices(), Moves(),
+    Permanent(), LatestVertexTimes(), LatestTime(-1) {}
+
+inline std::uint32_t ReservationTable::CellIndex(const Coordinate& coordinate) const
+{
+    return static_cast<std::uint32_t>(coordinate.GetRow() * NumberOfColumns + coordinate.GetColumn());
+}
+
+inline std::uint64_t ReservationTable::MoveIndex(const Coordinate& source, const Coordinate& target) const
+{
+    return (static_cast<std::uint64_t>(CellIndex(source)) << 32) | CellIndex(target);
+}
+
+void ReservationTable::Clear(const int number_of_columns)
+{
+    // the per timestep sets are emptied rather than released, so their buckets are reused by the next agent
+    NumberOfColumns = number_of_columns;
+    for(int time = 0; time <= LatestTime && time < static_cast<int>(Vertices.size()); time++)
+    {
+        Vertices[time].clear();
+        Moves[time].clear();
+    }
+    Permanent.clear();
+    LatestVertexTimes.clear();
+    LatestTime = -1;
+}
+
+void ReservationTable::AddVertexConstraint(const Coordinate& coordinate, const int time)
+{
+    if(time >= static_cast<int>(Vertices.size()))
+    {
+        Vertices.resize(time + 1);
+        Moves.resize(time + 1);
+    }
+    const std::uint32_t cell = CellIndex(coordinate);
+    Vertices[time].insert(cell);
+    int& latest_vertex_time = LatestVertexTimes.try_emplace(cell, -1).first->second;
+    latest_vertex_time = std::max(latest_vertex_time, time);
+    LatestTime = std::max(LatestTime, time);
+}
+
+void ReservationTable::AddMoveConstraint(const Coordinate& source, const Coordinate& target, const int time)
+{
+    if(time >= static_cast<int>(Moves.size()))
+    {
+        Vertices.resize(time + 1);
+        Moves.resize(time + 1);
+    }
+    Moves[time].insert(MoveIndex(source, target));
+    LatestTime = std::max(LatestTime, time);
+}
+
+void ReservationTable::AddPermanentConstraint(const Coordinate& coordinate, const int time)
+{
+    const std::uint32_t cell = CellIndex(coordinate);
+    auto [entry, is_inserted] = Permanent.try_emplace(cell, time);
+    if(!is_inserted)
+    {
+        entry->second = std::min(entry->second, time);
+    }
+    LatestVertexTimes[cell] = FOREVER;
+    LatestTime = std::max(LatestTime, time);
+}
+
+void ReservationTable::Reserve(const Path& path)
+{
+    if(path.empty())
+    {
+        return;
+    }
+    const int arrival_time = static_cast<int>(path.size()) - 1;
+    for(int time = 0; time < arrival_time; time++)
+    {
+        AddVertexConstraint(path[time], time);
+        if(path[time] != path[time + 1])
+        {
+            AddMoveConstraint(path[time + 1], path[time], time);
+        }
+    }
+    AddPermanentConstraint(path.back(), arrival_time);
+}
+
+bool ReservationTable::IsVertexFree(const Coordinate& coordinate, const int time) const
+{
+    const std::uint32_t cell = CellIndex(coordinate);
+    if(!Permanent.empty())
+    {
+        auto entry = Permanent.find(cell);
+        if(entry != Permanent.end() && entry->second <= time)
+        {
+            return false;
+        }
+    }
+    return time >= static_cast<int>(Vertices.size()) || !Vertices[time].contains(cell);
+}
+
+bool ReservationTable::IsMoveFree(const Coordinate& source, const Coordinate& target, const int time) const
+{
+    return time >= static_cast<int>(Moves.size()) || !Moves[time].contains(MoveIndex(source, target));
+}
+
+int ReservationTable::GetLatestTime(void) const
+{
+    return LatestTime;
+}
+
+int ReservationTable::GetLatestVertexTime(const Coordinate& coordinate) const
+{
+    auto entry = LatestVertexTimes.find(CellIndex(coordinate));
+    return (entry == LatestVertexTimes.end()) ? -1 : entry->second;
+}
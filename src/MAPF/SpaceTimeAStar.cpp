@@ -0,0 +1,191 @@
+#include "../../include/MAPF/SpaceTimeAStar.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Agent.h"
+#include "../../include/Common/Printer.h"
+#include "../../include/Common/Directions.h"
+#include <bit> // countr_zero()
+#include <algorithm> // reverse(), min()
+
+SpaceTimeAStar::SpaceTimeAStar(): ISingleAgentPathFinder(Chebyshev, UnitWeight), Nodes(), Lookup(), Distances(nullptr),
+    GoalDistances(nullptr), Constraints(nullptr), Active(nullptr), Unconstrained(), Horizon(0), NumberOfCells(0),
+    GoalNode(nullptr) {}
+
+SpaceTimeAStar::SpaceTimeAStar(const Map* map): ISingleAgentPathFinder(map, Chebyshev, UnitWeight), Nodes(), Lookup(),
+    Distances(nullptr), GoalDistances(nullptr), Constraints(nullptr), Active(nullptr), Unconstrained(), Horizon(0),
+    NumberOfCells(0), GoalNode(nullptr) {}
+
+void SpaceTimeAStar::SetDistanceCache(const std::shared_ptr<GoalDistanceCache>& distances)
+{
+    Distances = distances;
+}
+
+void SpaceTimeAStar::SetReservationTable(const ReservationTable* constraints)
+{
+    Constraints = constraints;
+}
+
+inline std::size_t SpaceTimeAStar::CellIndex(const Coordinate& coordinate) const
+{
+    return static_cast<std::size_t>(coordinate.GetRow()) * CurrentMap->GetNumberOfColumns() + coordinate.GetColumn();
+}
+
+inline std::uint64_t SpaceTimeAStar::StateIndex(const Coordinate& coordinate, const int time) const
+{
+    return CellIndex(coordinate) + static_cast<std::uint64_t>(std::min(time, Horizon)) * NumberOfCells;
+}
+
+inline bool SpaceTimeAStar::IsGoal(const SpaceTimeNode& node, const Coordinate& goal, const int goal_release_time) const
+{
+    return node.MyCoordinate == goal && node.Time >= goal_release_time;
+}
+
+void SpaceTimeAStar::Generate(SpaceTimeNode* root_node, const Coordinate& successor_coordinate, space_time_heap_t& open_set)
+{
+    const int successor_time = root_node->Time + 1;
+    auto [entry, is_inserted] = Lookup.try_emplace(StateIndex(successor_coordinate, successor_time), nullptr);
+    const double successor_static_value = successor_time + (*GoalDistances)[CellIndex(successor_coordinate)];
+    if(!is_inserted)
+    {
+        // only merged states beyond the horizon may be reached again, and then possibly at an earlier timestep
+        SpaceTimeNode* successor_node = entry->second;
+        if(!successor_node->IsExpanded && successor_node->Time > successor_time)
+        {
+            successor_node->Time = successor_time;
+            successor_node->Parent = root_node;
+            successor_node->StaticValue = successor_static_value;
+            open_set.decrease(successor_node);
+        }
+        return;
+    }
+    NumberOfGeneratedNodes++;
+    entry->second = &Nodes.emplace_back(successor_coordinate, successor_time, root_node, successor_static_value);
+    open_set.push(entry->second);
+}
+
+void SpaceTimeAStar::Expand(SpaceTimeNode* root_node, space_time_heap_t& open_set)
+{
+    NumberOfExpandedNodes++;
+    root_node->IsExpanded = true;
+    const Coordinate& root_coordinate = root_node->MyCoordinate;
+    const int time = root_node->Time;
+    if(Active->IsVertexFree(root_coordinate, time + 1))
+    {
+        Generate(root_node, root_coordinate, open_set); // wait
+    }
+    for(unsigned int directions = CurrentMap->GetNeighborMask(root_coordinate); directions != 0; directions &= directions - 1)
+    {
+        const Coordinate& direction = eight_principle_directions[std::countr_zero(directions)];
+        const Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
+                                                 root_coordinate.GetColumn() + direction.GetColumn()};
+        if(Active->IsVertexFree(successor_coordinate, time + 1) &&
+           Active->IsMoveFree(root_coordinate, successor_coordinate, time))
+        {
+            Generate(root_node, successor_coordinate, open_set);
+        }
+    }
+}
+
+bool SpaceTimeAStar::Search(const Coordinate& root_coordinate, const Coordinate& goal)
+{
+    const int goal_latest_time = Active->GetLatestVertexTime(goal);
+    if(goal_latest_time == ReservationTable::FOREVER || !Active->IsVertexFree(root_coordinate, 0))
+    {
+        return false;
+    }
+    const int goal_release_time = goal_latest_time + 1;
+
+    space_time_heap_t open_set;
+    SpaceTimeNode* root_node = &Nodes.emplace_back(root_coordinate, 0, nullptr, (*GoalDistances)[CellIndex(root_coordinate)]);
+    Lookup.emplace(StateIndex(root_coordinate, 0), root_node);
+    open_set.push(root_node);
+    while(!open_set.empty())
+    {
+        SpaceTimeNode* curr = open_set.top();
+        MaxHeapSize = std::max(open_set.size(), MaxHeapSize);
+
+        open_set.pop();
+        NumberOfPopOperations++;
+
+        if(IsGoal(*curr, goal, goal_release_time))
+        {
+            GoalNode = curr;
+            return true;
+        }
+
+        Expand(curr, open_set);
+    }
+    return false;
+}
+
+bool SpaceTimeAStar::Prepare(const Agent& agent)
+{
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent, true))
+    {
+        return false;
+    }
+    const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
+
+    Nodes.clear();
+    Lookup.clear();
+    GoalNode = nullptr;
+    if(Distances == nullptr || Distances->GetMap() != CurrentMap)
+    {
+        Distances = std::make_shared<GoalDistanceCache>(CurrentMap, UnitWeight);
+    }
+    if(Constraints == nullptr)
+    {
+        Unconstrained.Clear(CurrentMap->GetNumberOfColumns());
+        Active = &Unconstrained;
+    }
+    else
+    {
+        Active = Constraints;
+    }
+    Horizon = Active->GetLatestTime() + 1;
+    NumberOfCells = static_cast<std::uint64_t>(CurrentMap->GetNumberOfRows()) * CurrentMap->GetNumberOfColumns();
+
+    // unreachable cells are estimated as 0, hence a start other than the goal estimated as 0 cannot reach it
+    GoalDistances = Distances->Find(dst);
+    return CurrentMap->IsPassableCoordinate(src) && CurrentMap->IsPassableCoordinate(dst) &&
+           (src == dst || (*GoalDistances)[CellIndex(src)] > 0);
+}
+
+Path SpaceTimeAStar::ReconstructPath(void) const
+{
+    Path solution;
+    for(const SpaceTimeNode* node = GoalNode; node != nullptr; node = node->Parent)
+    {
+        solution.push_back(node->MyCoordinate);
+    }
+    std::reverse(solution.begin(), solution.end());
+    return solution;
+}
+
+std::size_t SpaceTimeAStar::GetMemoryUsage(void) const
+{
+    // every node, one lookup entry per node with its bucket, and one open-set entry per node at the largest open-set
+    return Nodes.size() * (sizeof(SpaceTimeNode) + sizeof(std::pair<const std::uint64_t, SpaceTimeNode*>) + 2 * sizeof(void*)) +
+           Lookup.bucket_count() * sizeof(void*) + MaxHeapSize * sizeof(SpaceTimeNode*);
+}
+
+Path SpaceTimeAStar::Solve(const Agent& agent)
+{
+    return std::get<0>(SolveFullReport(agent));
+}
+
+Report SpaceTimeAStar::SolveFullReport(const Agent& agent)
+{
+    if(!Prepare(agent))
+    {
+        return {Path(), agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, 0, 0, 0.0};
+    }
+    Path path;
+    if(Search(agent.GetStartCoordinate(), agent.GetGoalCoordinate()))
+    {
+        path = ReconstructPath();
+    }
+    PeakMemory = GetMemoryUsage();
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            path.empty() ? 0.0 : 1.0};
+}
@@ -0,0 +1,14 @@
+#include "../../include/MAPF/SpaceTimeNode.h"
+#include <limits>
+
+SpaceTimeNode::SpaceTimeNode(): MyCoordinate(), Time(0), Parent(nullptr),
+    StaticValue(std::numeric_limits<double>::max()), IsExpanded(false), HeapIndex(0) {}
+
+SpaceTimeNode::SpaceTimeNode(const Coordinate& coordinate, const int time, SpaceTimeNode* const parent, const double f):
+    MyCoordinate(coordinate), Time(time), Parent(parent), StaticValue(f), IsExpanded(false), HeapIndex(0) {}
+
+bool SpaceTimeNodeComparator::operator()(const SpaceTimeNode *n1, const SpaceTimeNode *n2) const
+{
+    // on equal f-values prefer the later node, it is closer to the goal
+    return (n1->StaticValue == n2->StaticValue) ? (n1->Time < n2->Time) : (n1->StaticValue > n2->StaticValue);
+}
@@ -0,0 +1,377 @@
+#include "../../include/MM/MM.h"
+#include "../../include/Common/Map.h"
+#include "../../include/Common/Agent.h"
+#include "../../include/Common/Printer.h"
+#include "../../include/Common/Directions.h"
+#include <thread>
+#include <limits>
+#include <algorithm> // min(), max(), reverse()
+#include <bit> // countr_zero()
+
+const double POSITIVE_INFINITY = std::numeric_limits<double>::max();
+
+MM::MM(const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(heuristic, weight), Frontiers(),
+    OpenList(AutomaticOpenList), IsConcurrent(false), NumberOfCells(0), BestCost(POSITIVE_INFINITY), Meeting(0),
+    MeetingMutex(), IsDone(false) {}
+
+MM::MM(const Map* map, const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(map, heuristic, weight),
+    Frontiers(), OpenList(AutomaticOpenList), IsConcurrent(false), NumberOfCells(0), BestCost(POSITIVE_INFINITY),
+    Meeting(0), MeetingMutex(), IsDone(false) {}
+
+MM::MM(const Map* map, const HeuristicFunction& heuristic, const WeightFunction& weight, const CostStructure costs):
+    ISingleAgentPathFinder(map, heuristic, weight, costs), Frontiers(), OpenList(AutomaticOpenList), IsConcurrent(false),
+    NumberOfCells(0), BestCost(POSITIVE_INFINITY), Meeting(0), MeetingMutex(), IsDone(false) {}
+
+void MM::SetOpenList(const OpenListType open_list)
+{
+    OpenList = open_list;
+}
+
+void MM::SetConcurrent(const bool is_concurrent)
+{
+    IsConcurrent = is_concurrent;
+}
+
+template<bool Concurrent>
+double MM::GetOppositeCost(const SearchDirection direction, const CellId cell)
+{
+    Frontier& opposite = Frontiers[1 - direction];
+    if constexpr(Concurrent)
+    {
+        return opposite.Costs[cell].load();
+    }
+    const AStarNode* node = opposite.Lookup.Find(cell);
+    return (node != nullptr) ? node->SumOfWeights : POSITIVE_INFINITY;
+}
+
+template<bool Concurrent>
+void MM::SetCost(const SearchDirection direction, const CellId cell, const double cost)
+{
+    // a search publishes its g-value before it reads the opposite one, and so does the other search, hence a cell
+    // reached by both at the same time is seen as a meeting by at least one of them
+    if constexpr(Concurrent)
+    {
+        Frontiers[direction].Costs[cell].store(cost);
+    }
+}
+
+template<bool Concurrent>
+void MM::UpdateMeeting(const CellId cell, const double cost)
+{
+    if constexpr(Concurrent)
+    {
+        std::lock_guard<std::mutex> lock(MeetingMutex);
+        if(cost < BestCost.load())
+        {
+            Meeting = cell;
+            BestCost.store(cost);
+        }
+    }
+    else if(cost < BestCost.load(std::memory_order_relaxed))
+    {
+        Meeting = cell;
+        BestCost.store(cost, std::memory_order_relaxed);
+    }
+}
+
+template<bool Concurrent, typename OpenSet, typename Model>
+void MM::Generate(const SearchDirection direction, AStarNode* root_node, const Coordinate& root_coordinate,
+                  const CellId successor, const Coordinate& successor_coordinate, OpenSet& open_set, const Model& model)
+{
+    Frontier& frontier = Frontiers[direction];
+    // moves of the backward search are reversed, they lead from the successor to the root
+    const double weight = (direction == Forward) ? model.W(root_coordinate, successor_coordinate) :
+                                                   model.W(successor_coordinate, root_coordinate);
+    const double successor_sum_of_weights = root_node->SumOfWeights + weight;
+    AStarNode* successor_node = frontier.Lookup.Find(successor);
+    if(successor_node != nullptr && successor_node->SumOfWeights <= successor_sum_of_weights)
+    {
+        return;
+    }
+    const double successor_priority = std::max(successor_sum_of_weights + model.H(successor_coordinate, frontier.Target),
+                                               2 * successor_sum_of_weights);
+
+    frontier.Lookup.SetParent(successor, frontier.Lookup.GetCellId(root_node));
+    if(successor_node == nullptr)
+    {
+        frontier.NumberOfGeneratedNodes++;
+        AStarNode& node = frontier.Lookup[successor];
+        node = {successor_priority, successor_sum_of_weights};
+        open_set.push(&node);
+    }
+    else
+    {
+        successor_node->SumOfWeights = successor_sum_of_weights;
+        successor_node->StaticValue = successor_priority;
+        if(frontier.Lookup.HasStatus(successor, ClosedStatus))
+        {
+            // expansions are not ordered by f, hence a closed node may be reached by a cheaper path later on
+            frontier.Lookup.ClearStatus(successor, ClosedStatus);
+            open_set.push(successor_node);
+        }
+        else
+        {
+            open_set.decrease(successor_node);
+        }
+    }
+
+    SetCost<Concurrent>(direction, successor, successor_sum_of_weights);
+    const double opposite_sum_of_weights = GetOppositeCost<Concurrent>(direction, successor);
+    if(opposite_sum_of_weights < POSITIVE_INFINITY)
+    {
+        UpdateMeeting<Concurrent>(successor, successor_sum_of_weights + opposite_sum_of_weights);
+    }
+}
+
+template<bool Concurrent, typename OpenSet, typename Model>
+void MM::Expand(const SearchDirection direction, AStarNode* root_node, OpenSet& open_set, const Model& model)
+{
+    Store& lookup = Frontiers[direction].Lookup;
+    Frontiers[direction].NumberOfExpandedNodes++;
+    const CellId root = lookup.GetCellId(root_node);
+    lookup.SetStatus(root, ClosedStatus);
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
+    // a move between two cells requires only its target to be passable, hence the passable neighbors of a cell
+    // are both the cells it leads to and, as the cell itself is passable, the cells leading to it
+    for(unsigned int directions = CurrentMap->GetNeighborMask(root); directions != 0; directions &= directions - 1)
+    {
+        const int i = std::countr_zero(directions);
+        const Coordinate& step = eight_principle_directions[i];
+        const Coordinate successor_coordinate = {root_coordinate.GetRow() + step.GetRow(),
+                                                 root_coordinate.GetColumn() + step.GetColumn()};
+        Generate<Concurrent>(direction, root_node, root_coordinate, root + offsets[i], successor_coordinate, open_set, model);
+    }
+}
+
+template<bool Concurrent, typename OpenSet, typename Model>
+void MM::Initialize(const SearchDirection direction, const Coordinate& root_coordinate, const Coordinate& target,
+                    OpenSet& open_set, const Model& model)
+{
+    // the root is its own parent, which terminates path reconstruction
+    Frontier& frontier = Frontiers[direction];
+    frontier.Root = root_coordinate;
+    frontier.Target = target;
+    const CellId root = CurrentMap->GetCellId(root_coordinate);
+    AStarNode& root_node = frontier.Lookup[root];
+    root_node = {model.H(root_coordinate, target), 0};
+    frontier.Lookup.SetParent(root, root);
+    frontier.MinPriority.store(root_node.StaticValue);
+    open_set.push(&root_node);
+
+    SetCost<Concurrent>(direction, root, 0);
+    const double opposite_sum_of_weights = GetOppositeCost<Concurrent>(direction, root);
+    if(opposite_sum_of_weights < POSITIVE_INFINITY)
+    {
+        UpdateMeeting<Concurrent>(root, opposite_sum_of_weights);
+    }
+}
+
+template<typename OpenSet, typename Model>
+bool MM::Search(const Coordinate root_coordinate, const Coordinate& goal, const Model& model)
+{
+    std::array<OpenSet, NSearchDirection> open_sets;
+    Initialize<false>(Forward, root_coordinate, goal, open_sets[Forward], model);
+    Initialize<false>(Backward, goal, root_coordinate, open_sets[Backward], model);
+
+    // once either open-set is exhausted, every cell reachable in its direction has its final g-value, and the
+    // cheapest path, if any, has been met already
+    while(!open_sets[Forward].empty() && !open_sets[Backward].empty())
+    {
+        const double forward_priority = open_sets[Forward].top()->StaticValue;
+        const double backward_priority = open_sets[Backward].top()->StaticValue;
+        if(BestCost.load(std::memory_order_relaxed) <= std::min(forward_priority, backward_priority))
+        {
+            break;
+        }
+
+        const SearchDirection direction = (forward_priority <= backward_priority) ? Forward : Backward;
+        Frontier& frontier = Frontiers[direction];
+        OpenSet& open_set = open_sets[direction];
+        AStarNode* curr = open_set.top();
+        frontier.MaxHeapSize = std::max(open_set.size(), frontier.MaxHeapSize);
+        open_set.pop();
+        frontier.NumberOfPopOperations++;
+        Expand<false>(direction, curr, open_set, model);
+    }
+    return BestCost.load(std::memory_order_relaxed) < POSITIVE_INFINITY;
+}
+
+template<typename OpenSet, typename Model>
+void MM::Advance(const SearchDirection direction, OpenSet& open_set, const Model& model)
+{
+    // the smallest priority of a direction never decreases, as successors have both greater g and no smaller f,
+    // hence the priority last published by the opposite search is a valid lower bound in the termination rule
+    Frontier& frontier = Frontiers[direction];
+    const Frontier& opposite = Frontiers[1 - direction];
+    while(!IsDone.load() && !open_set.empty())
+    {
+        const double priority = open_set.top()->StaticValue;
+        frontier.MinPriority.store(priority);
+        if(BestCost.load() <= std::min(priority, opposite.MinPriority.load()))
+        {
+            break;
+        }
+
+        AStarNode* curr = open_set.top();
+        frontier.MaxHeapSize = std::max(open_set.size(), frontier.MaxHeapSize);
+        open_set.pop();
+        frontier.NumberOfPopOperations++;
+        Expand<true>(direction, curr, open_set, model);
+    }
+    IsDone.store(true);
+}
+
+template<typename OpenSet, typename Model>
+bool MM::SearchConcurrently(const Coordinate root_coordinate, const Coordinate& goal, const Model& model)
+{
+    const std::size_t number_of_cells = static_cast<std::size_t>(CurrentMap->GetNumberOfRows()) * CurrentMap->GetNumberOfColumns();
+    for(Frontier& frontier : Frontiers)
+    {
+        if(NumberOfCells != number_of_cells)
+        {
+            frontier.Costs = std::make_unique<std::atomic<double>[]>(number_of_cells);
+        }
+        for(std::size_t cell = 0; cell < number_of_cells; cell++)
+        {
+            frontier.Costs[cell].store(POSITIVE_INFINITY, std::memory_order_relaxed);
+        }
+    }
+    NumberOfCells = number_of_cells;
+
+    std::array<OpenSet, NSearchDirection> open_sets;
+    Initialize<true>(Forward, root_coordinate, goal, open_sets[Forward], model);
+    Initialize<true>(Backward, goal, root_coordinate, open_sets[Backward], model);
+    IsDone.store(false);
+
+    std::thread forward_search([&]()
+    {
+        Advance(Forward, open_sets[Forward], model);
+    });
+    Advance(Backward, open_sets[Backward], model);
+    forward_search.join();
+    return BestCost.load() < POSITIVE_INFINITY;
+}
+
+bool MM::Search(const Coordinate root_coordinate, const Coordinate& goal)
+{
+    if(root_coordinate != goal && !CurrentMap->IsPassableCoordinate(goal))
+    {
+        return false; // no move leads to an impassable cell, while the backward search would leave it
+    }
+    const OpenListType open_list = SelectOpenList(OpenList);
+    return WithCostModel([&](const auto& model)
+    {
+        auto search = [&]<typename OpenSet>()
+        {
+            return IsConcurrent ? SearchConcurrently<OpenSet>(root_coordinate, goal, model) :
+                                  Search<OpenSet>(root_coordinate, goal, model);
+        };
+        switch(open_list)
+        {
+            case FibonacciHeapOpenList:
+                return search.template operator()<fibonacci_heap_t>();
+            case BucketOpenList:
+                return search.template operator()<bucket_queue_t>();
+            case IntegralBucketOpenList:
+                return search.template operator()<integral_bucket_queue_t>();
+            default:
+                return search.template operator()<quaternary_heap_t>();
+        }
+    });
+}
+
+Path MM::ReconstructPath(const Agent& agent)
+{
+    Path solution;
+    const CellId start = CurrentMap->GetCellId(agent.GetStartCoordinate()), goal = CurrentMap->GetCellId(agent.GetGoalCoordinate());
+    // from the meeting cell back to the start over the forward search's parents
+    for(CellId current = Meeting; ; current = Frontiers[Forward].Lookup.GetParent(current))
+    {
+        solution.push_back(CurrentMap->GetCoordinate(current));
+        if(current == start)
+        {
+            break;
+        }
+    }
+    std::reverse(solution.begin(), solution.end());
+
+    // from the meeting cell on to the goal over the backward search's parents
+    for(CellId current = Meeting; current != goal; )
+    {
+        current = Frontiers[Backward].Lookup.GetParent(current);
+        solution.push_back(CurrentMap->GetCoordinate(current));
+    }
+
+    return solution;
+}
+
+bool MM::Prepare(const Agent& agent)
+{
+    // nodes are stored per map cell in both directions, the goal is a root as well
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent, true))
+    {
+        return false;
+    }
+    for(Frontier& frontier : Frontiers)
+    {
+        frontier.Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+        frontier.NumberOfExpandedNodes = frontier.NumberOfGeneratedNodes = frontier.NumberOfPopOperations = 0;
+        frontier.MaxHeapSize = 0;
+    }
+    BestCost.store(POSITIVE_INFINITY);
+    return true;
+}
+
+void MM::CollectStatistics(void)
+{
+    // the open-sets of both directions coexist, their largest sizes are summed as a bound on the overall one
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+    PeakMemory = 0;
+    for(const Frontier& frontier : Frontiers)
+    {
+        NumberOfExpandedNodes += frontier.NumberOfExpandedNodes;
+        NumberOfGeneratedNodes += frontier.NumberOfGeneratedNodes;
+        NumberOfPopOperations += frontier.NumberOfPopOperations;
+        MaxHeapSize += frontier.MaxHeapSize;
+        PeakMemory += frontier.Lookup.GetMemoryUsage() + frontier.MaxHeapSize * sizeof(AStarNode*);
+    }
+    if(IsConcurrent)
+    {
+        PeakMemory += NSearchDirection * NumberOfCells * sizeof(std::atomic<double>);
+    }
+}
+
+Path MM::Solve(const Agent& agent)
+{
+    if(!Prepare(agent))
+    {
+        return {};
+    }
+    const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
+    // a goal outside of the component of the start is rejected without a search
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
+    if(is_solution_found)
+    {
+        return ReconstructPath(agent);
+    }
+    return {};
+}
+
+Report MM::SolveFullReport(const Agent& agent)
+{
+    if(!Prepare(agent))
+    {
+        return {};
+    }
+    const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
+    Path path;
+    if(is_solution_found)
+    {
+        path = ReconstructPath(agent);
+    }
+    CollectStatistics();
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            path.empty() ? 0.0 : 1.0};
+}
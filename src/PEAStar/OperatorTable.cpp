@@ -0,0 +1,32 @@
+#include "../../include/PEAStar/OperatorTable.h"
+#include <cstdlib> // abs()
+
+OperatorTable::OperatorTable(): Groups(), NumberOfGroups() {}
+
+std::size_t OperatorTable::ClassOf(const Coordinate& node, const Coordinate& goal)
+{
+    const int row_offset = goal.GetRow() - node.GetRow(), column_offset = goal.GetColumn() - node.GetColumn();
+    const int row_sign = (row_offset > 0) - (row_offset < 0), column_sign = (column_offset > 0) - (column_offset < 0);
+    const int difference = std::clamp(std::abs(row_offset) - std::abs(column_offset), -2, 2);
+    return static_cast<std::size_t>((row_sign + 1) * 15 + (column_sign + 1) * 5 + (difference + 2));
+}
+
+std::size_t OperatorTable::Find(const std::size_t cls, const std::size_t first, const std::uint8_t mask) const
+{
+    std::size_t group = first;
+    while(group < NumberOfGroups[cls] && (Groups[cls][group].Directions & mask) == 0)
+    {
+        group++;
+    }
+    return group;
+}
+
+std::size_t OperatorTable::GetNumberOfGroups(const std::size_t cls) const
+{
+    return NumberOfGroups[cls];
+}
+
+const OperatorTable::Group& OperatorTable::GetGroup(const std::size_t cls, const std::size_t group) const
+{
+    return Groups[cls][group];
+}
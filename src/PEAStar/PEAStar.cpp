@@ -4,57 +4,64 @@
 #include "../../include/Common/Printer.h"
 #include "../../include/Common/Directions.h"
 #include <cmath>
+#include <bit> // countr_zero()
 
 const double POSITIVE_INFINITY = std::numeric_limits<double>::max();
 
-PEAStar::PEAStar(const Heuristic heuristic): ISingleAgentPathFinder(heuristic), Lookup() {}
+PEAStar::PEAStar(const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(heuristic, weight), Lookup(),
+    OpenList(AutomaticOpenList), Expansion(PartialExpansion), Operators() {}
 
-PEAStar::PEAStar(Map* map, const Heuristic heuristic): ISingleAgentPathFinder(map, heuristic), Lookup() {}
+PEAStar::PEAStar(const Map* map, const Heuristic heuristic, const Weight weight):
+    ISingleAgentPathFinder(map, heuristic, weight), Lookup(),
+    OpenList(AutomaticOpenList), Expansion(PartialExpansion), Operators() {}
 
-PEAStar::PEAStar(Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight):
-        ISingleAgentPathFinder(map, heuristic, weight), Lookup() {}
+PEAStar::PEAStar(const Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight, const CostStructure costs):
+        ISingleAgentPathFinder(map, heuristic, weight, costs), Lookup(), OpenList(AutomaticOpenList),
+        Expansion(PartialExpansion), Operators() {}
 
-bool PEAStar::IsNodeExpanded(const Coordinate& coordinate)
+void PEAStar::SetOpenList(const OpenListType open_list)
 {
-    if(Lookup.find(coordinate) != Lookup.end())
-    {
-        return Lookup[coordinate].IsExpanded;
-    }
-    return false;
+    OpenList = open_list;
 }
 
-bool PEAStar::IsNodeWithinOpenSet(const Coordinate& coordinate)
+void PEAStar::SetExpansionMode(const ExpansionMode expansion)
 {
-    if(Lookup.find(coordinate) != Lookup.end())
-    {
-        return Lookup[coordinate].IsOpen;
-    }
-    return false;
+    Expansion = expansion;
+}
+
+bool PEAStar::IsNodeExpanded(const CellId cell)
+{
+    return Lookup.HasStatus(cell, ClosedStatus);
 }
 
-bool PEAStar::IsLegalSuccessor(const Coordinate& successor_coordinate)
+bool PEAStar::IsNodeWithinOpenSet(const CellId cell)
 {
-    return CurrentMap->IsValidCoordinate(successor_coordinate) &&
-           CurrentMap->IsPassableCoordinate(successor_coordinate) &&
-           !IsNodeExpanded(successor_coordinate) && // successor belongs to close-set
-           !IsNodeWithinOpenSet(successor_coordinate); // to avoid infinite loops when node is re-expanded
+    return Lookup.HasStatus(cell, OpenStatus);
 }
 
-double PEAStar::Generate(PEAStarNode* root_node, const Coordinate& successor_coordinate, const Coordinate& goal, binomial_heap_t& open_set)
+bool PEAStar::IsLegalSuccessor(const CellId successor)
+{
+    return !IsNodeExpanded(successor) && // successor belongs to close-set
+           !IsNodeWithinOpenSet(successor); // to avoid infinite loops when node is re-expanded
+}
+
+template<typename OpenSet, typename Model>
+double PEAStar::Generate(PEAStarNode* root_node, const Coordinate& root_coordinate, const CellId successor,
+                         const Coordinate& successor_coordinate, const Coordinate& goal, OpenSet& open_set, const Model& model)
 {
     NumberOfGeneratedNodes++;
     // calculate static value(f) , sum of weights(g), stored value(F) for successor
-    const Coordinate& root_coordinate = root_node->MyCoordinate;
-    PEAStarNode& successor_node = Lookup[successor_coordinate];
-    double successor_sum_of_weights = root_node->SumOfWeights + W(root_coordinate, successor_coordinate);
-    double successor_heuristic_estimation = H(successor_coordinate, goal);
+    PEAStarNode& successor_node = Lookup[successor];
+    double successor_sum_of_weights = root_node->SumOfWeights + model.W(root_coordinate, successor_coordinate);
+    double successor_heuristic_estimation = model.H(successor_coordinate, goal);
     double successor_static_value = successor_sum_of_weights + successor_heuristic_estimation;
-    successor_node = {successor_coordinate, root_coordinate, successor_static_value, successor_static_value, successor_sum_of_weights};
+    successor_node = {successor_static_value, successor_static_value, successor_sum_of_weights};
+    Lookup.SetParent(successor, Lookup.GetCellId(root_node));
 
     if(successor_static_value <= root_node->StoredValue)
     {
         open_set.push(&successor_node);
-        successor_node.IsOpen = true;
+        Lookup.SetStatus(successor, OpenStatus);
         return POSITIVE_INFINITY;
     }
     else
@@ -64,49 +71,143 @@ double PEAStar::Generate(PEAStarNode* root_node, const Coordinate& successor_coo
 
 }
 
-void PEAStar::Collapse(PEAStarNode *root_node, const double least_successor_static_value, binomial_heap_t& open_set)
+template<typename OpenSet>
+void PEAStar::Collapse(PEAStarNode *root_node, const double least_successor_static_value, OpenSet& open_set)
 {
     if(least_successor_static_value == POSITIVE_INFINITY)
     {
-        root_node->IsExpanded = true;
+        Lookup.SetStatus(Lookup.GetCellId(root_node), ClosedStatus);
     }
     else
     {
         root_node->StoredValue = least_successor_static_value;
-        root_node->IsOpen = true;
+        Lookup.SetStatus(Lookup.GetCellId(root_node), OpenStatus);
         open_set.push(root_node);
     }
 }
 
-void PEAStar::Expand(PEAStarNode* root_node, const Coordinate& goal, binomial_heap_t& open_set)
+template<typename OpenSet, typename Model>
+void PEAStar::Expand(PEAStarNode* root_node, const Coordinate& goal, OpenSet& open_set, const Model& model)
 {
     NumberOfExpandedNodes++;
-    root_node->IsOpen = false;
-    const Coordinate& root_coordinate = root_node->MyCoordinate;
+    const CellId root = Lookup.GetCellId(root_node);
+    Lookup.ClearStatus(root, OpenStatus);
+    // the coordinate is needed by the cost model only, successors are addressed by their cell id
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
     double least_successor_static_value = POSITIVE_INFINITY;
-    for(const auto& direction : eight_principle_directions)
+    for(unsigned int directions = CurrentMap->GetNeighborMask(root); directions != 0; directions &= directions - 1)
     {
-        Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
-                                           root_coordinate.GetColumn() + direction.GetColumn()};
-
-        if(IsLegalSuccessor(successor_coordinate))
+        const int i = std::countr_zero(directions);
+        const CellId successor = root + offsets[i];
+        if(IsLegalSuccessor(successor))
         {
+            const Coordinate& direction = eight_principle_directions[i];
+            Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
+                                               root_coordinate.GetColumn() + direction.GetColumn()};
             least_successor_static_value = std::min(least_successor_static_value,
-                                                    Generate(root_node, successor_coordinate, goal, open_set));
+                Generate(root_node, root_coordinate, successor, successor_coordinate, goal, open_set, model));
         }
     }
     Collapse(root_node, least_successor_static_value, open_set);
 }
 
-bool PEAStar::Search(const Coordinate root_coordinate, const Coordinate& goal)
+template<typename OpenSet, typename Model>
+void PEAStar::GenerateEnhanced(PEAStarNode* root_node, const Coordinate& root_coordinate, const CellId successor,
+                               const Coordinate& successor_coordinate, const Coordinate& goal, OpenSet& open_set,
+                               const Model& model)
+{
+    // a closed successor is never reached cheaper under a consistent heuristic, an open one is updated when it is
+    if(Lookup.HasStatus(successor, ClosedStatus))
+    {
+        return;
+    }
+    PEAStarNode* successor_node = Lookup.Find(successor);
+    const double successor_sum_of_weights = root_node->SumOfWeights + model.W(root_coordinate, successor_coordinate);
+    if(successor_node != nullptr && Lookup.HasStatus(successor, OpenStatus))
+    {
+        if(successor_sum_of_weights >= successor_node->SumOfWeights)
+        {
+            return;
+        }
+        // a cheaper path restarts the selection of its operators, since its f-value has dropped
+        const double successor_static_value = successor_sum_of_weights + (successor_node->StaticValue - successor_node->SumOfWeights);
+        Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+        successor_node->SumOfWeights = successor_sum_of_weights;
+        successor_node->StaticValue = successor_node->StoredValue = successor_static_value;
+        successor_node->OperatorGroup = 0;
+        open_set.decrease(successor_node);
+        return;
+    }
+    NumberOfGeneratedNodes++;
+    const double successor_static_value = successor_sum_of_weights + model.H(successor_coordinate, goal);
+    PEAStarNode& node = Lookup[successor];
+    node = {successor_static_value, successor_static_value, successor_sum_of_weights};
+    Lookup.SetParent(successor, Lookup.GetCellId(root_node));
+    Lookup.SetStatus(successor, OpenStatus);
+    open_set.push(&node);
+}
+
+template<typename OpenSet, typename Model>
+void PEAStar::ExpandEnhanced(PEAStarNode* root_node, const Coordinate& goal, OpenSet& open_set, const Model& model)
+{
+    /*
+     * Generate only the group of moves whose change of f is the least among the moves not applied yet, as given by
+     * the operator selection function. The node is queued again with the change of f of the following group as its
+     * stored value, and is closed once no group is left. Moves into blocked cells are never looked at.
+     */
+    NumberOfExpandedNodes++;
+    const CellId root = Lookup.GetCellId(root_node);
+    Lookup.ClearStatus(root, OpenStatus);
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
+    const std::size_t cls = OperatorTable::ClassOf(root_coordinate, goal);
+    const std::uint8_t mask = CurrentMap->GetNeighborMask(root);
+    const std::size_t group = Operators.Find(cls, root_node->OperatorGroup, mask);
+    if(group < Operators.GetNumberOfGroups(cls))
+    {
+        for(unsigned int directions = Operators.GetGroup(cls, group).Directions & mask; directions != 0; directions &= directions - 1)
+        {
+            const int i = std::countr_zero(directions);
+            const Coordinate& direction = eight_principle_directions[i];
+            GenerateEnhanced(root_node, root_coordinate, root + offsets[i],
+                             {root_coordinate.GetRow() + direction.GetRow(), root_coordinate.GetColumn() + direction.GetColumn()},
+                             goal, open_set, model);
+        }
+    }
+    const std::size_t next_group = Operators.Find(cls, group + 1, mask);
+    if(next_group >= Operators.GetNumberOfGroups(cls))
+    {
+        Lookup.SetStatus(root, ClosedStatus);
+        return;
+    }
+    root_node->OperatorGroup = static_cast<std::uint8_t>(next_group);
+    root_node->StoredValue = root_node->StaticValue + Operators.GetGroup(cls, next_group).Delta;
+    Lookup.SetStatus(root, OpenStatus);
+    open_set.push(root_node);
+}
+
+template<typename OpenSet, typename Model>
+bool PEAStar::Search(const Coordinate root_coordinate, const Coordinate& goal, const Model& model)
 {
     // create PEAStarNode for root and insert in to both Lookup table and open set
-    binomial_heap_t open_set;
-    const double root_heuristic_estimation = H(root_coordinate, goal);
-    Lookup[root_coordinate] = {root_coordinate, root_heuristic_estimation, root_heuristic_estimation, 0};
-    PEAStarNode& root_node = Lookup[root_coordinate];
+    OpenSet open_set;
+    const CellId root = CurrentMap->GetCellId(root_coordinate), goal_cell = CurrentMap->GetCellId(goal);
+    const double root_heuristic_estimation = model.H(root_coordinate, goal);
+    PEAStarNode& root_node = Lookup[root];
+    root_node = {root_heuristic_estimation, root_heuristic_estimation, 0};
+    Lookup.SetParent(root, root);
     open_set.push(&root_node);
-    root_node.IsOpen = true;
+    Lookup.SetStatus(root, OpenStatus);
+    bool is_enhanced = false;
+    if constexpr(IsOperatorSelectable<Model>::value)
+    {
+        is_enhanced = Expansion == EnhancedPartialExpansion;
+        if(is_enhanced)
+        {
+            Operators.Build(model);
+        }
+    }
 
     while(!open_set.empty())
     {
@@ -116,29 +217,61 @@ bool PEAStar::Search(const Coordinate root_coordinate, const Coordinate& goal)
         open_set.pop();
         NumberOfPopOperations++;
 
-        if(IsGoal(curr->MyCoordinate, goal))
+        if(Lookup.GetCellId(curr) == goal_cell)
         {
             return true;
         }
 
-        Expand(curr, goal, open_set);
+        if(is_enhanced)
+        {
+            ExpandEnhanced(curr, goal, open_set, model);
+        }
+        else
+        {
+            Expand(curr, goal, open_set, model);
+        }
     }
     return false;
 }
 
+bool PEAStar::Search(const Coordinate root_coordinate, const Coordinate& goal)
+{
+    const OpenListType open_list = SelectOpenList(OpenList);
+    return WithCostModel([&](const auto& model)
+    {
+        if(TieOrder == DeepTieBreak)
+        {
+            return (open_list == FibonacciHeapOpenList) ? Search<deep_fibonacci_heap_t>(root_coordinate, goal, model) :
+                                                          Search<deep_quaternary_heap_t>(root_coordinate, goal, model);
+        }
+        switch(open_list)
+        {
+            case FibonacciHeapOpenList:
+                return Search<fibonacci_heap_t>(root_coordinate, goal, model);
+            case BucketOpenList:
+                return Search<bucket_queue_t>(root_coordinate, goal, model);
+            case IntegralBucketOpenList:
+                return Search<integral_bucket_queue_t>(root_coordinate, goal, model);
+            default:
+                return Search<quaternary_heap_t>(root_coordinate, goal, model);
+        }
+    });
+}
+
 Path PEAStar::ReconstructPath(const Agent& agent)
 {
-    Coordinate current = Lookup[agent.GetGoalCoordinate()].MyCoordinate;
-    const Coordinate& source = Lookup[agent.GetStartCoordinate()].MyCoordinate;
+    // cells are converted to coordinates only here, once the path is handed out
+    CellId current = CurrentMap->GetCellId(agent.GetGoalCoordinate());
+    const CellId source = CurrentMap->GetCellId(agent.GetStartCoordinate());
     Path solution;
 
     while(current != source)
     {
-        solution.emplace_back(current);
-        current = Lookup[current].Parent;
+        solution.emplace_back(CurrentMap->GetCoordinate(current));
+        current = Lookup.GetParent(current);
     }
 
-    solution.push_back(source);
+    solution.push_back(agent.GetStartCoordinate());
     std::reverse(solution.begin(), solution.end());
 
     return solution;
@@ -146,14 +279,14 @@ Path PEAStar::ReconstructPath(const Agent& agent)
 
 Path PEAStar::Solve(const Agent& agent)
 {
-    if(CurrentMap == nullptr)
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
     {
-        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nulltptr!\n");
         return {};
     }
-    Lookup.clear();
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
     const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
-    bool is_solution_found = Search(src, dst);
+    // a goal outside of the component of the start is rejected without a search
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
     if(is_solution_found)
     {
         return ReconstructPath(agent);
@@ -163,25 +296,33 @@ Path PEAStar::Solve(const Agent& agent)
 
 Report PEAStar::SolveFullReport(const Agent& agent)
 {
-    if(CurrentMap == nullptr)
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
     {
-        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nulltptr!\n");
         return {};
     }
-    Lookup.clear();
+    Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
     const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
     NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
-    bool is_solution_found = Search(src, dst);
+    bool is_solution_found = CurrentMap->AreConnected(src, dst) && Search(src, dst);
     Path path;
     if(is_solution_found)
     {
         path = ReconstructPath(agent);
     }
-    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize};
+    // node slots of the whole grid, and one open-set entry per node at the largest open-set
+    PeakMemory = Lookup.GetMemoryUsage() + MaxHeapSize * sizeof(PEAStarNode*);
+    return {path, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            path.empty() ? 0.0 : 1.0};
 }
 
 bool PEAStarNodeComparator::operator()(const PEAStarNode *n1, const PEAStarNode *n2) const
 {
-    return (n1->StaticValue == n2->StaticValue) ? (n1->SumOfWeights > n2->SumOfWeights) :
-           (n1->StaticValue > n2->StaticValue);
+    return (n1->StoredValue == n2->StoredValue) ? (n1->SumOfWeights > n2->SumOfWeights) :
+           (n1->StoredValue > n2->StoredValue);
+}
+
+bool DeepPEAStarNodeComparator::operator()(const PEAStarNode *n1, const PEAStarNode *n2) const
+{
+    return IsTie(n1->StoredValue, n2->StoredValue) ? (n1->SumOfWeights < n2->SumOfWeights) :
+           (n1->StoredValue > n2->StoredValue);
 }
\ No newline at end of file
@@ -4,41 +4,70 @@
 #include "../../include/Common/Printer.h"
 #include "../../include/Common/Directions.h"
 #include <cmath>
+#include <bit> // countr_zero()
+#include <limits>
 
 const double POSITIVE_INFINITY = std::numeric_limits<double>::max();
 
-RBFS::RBFS(const Heuristic heuristic): ISingleAgentPathFinder(heuristic), Lookup() {}
+RBFS::RBFS(const Heuristic heuristic, const Weight weight): ISingleAgentPathFinder(heuristic, weight),
+    Memory(RetainedMemory), Lookup(), Root(), Children(), OnPath(), Frames(), MaxDepth(0) {}
 
-RBFS::RBFS(Map* map, const Heuristic heuristic): ISingleAgentPathFinder(map, heuristic), Lookup() {}
+RBFS::RBFS(const Map* map, const Heuristic heuristic, const Weight weight):
+    ISingleAgentPathFinder(map, heuristic, weight), Memory(RetainedMemory), Lookup(), Root(), Children(), OnPath(),
+    Frames(), MaxDepth(0) {}
 
-RBFS::RBFS(Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight):
-ISingleAgentPathFinder(map, heuristic, weight), Lookup() {}
+RBFS::RBFS(const Map* map, const HeuristicFunction &heuristic, const WeightFunction &weight, const CostStructure costs):
+ISingleAgentPathFinder(map, heuristic, weight, costs), Memory(RetainedMemory), Lookup(), Root(), Children(), OnPath(),
+    Frames(), MaxDepth(0) {}
 
-bool RBFS::IsGenerated(const Coordinate& coordinate)
+void RBFS::SetMemoryMode(const MemoryMode memory)
 {
-    return Lookup.find(coordinate) != Lookup.end();
+    Memory = memory;
 }
 
-bool RBFS::IsLegalSuccessor(const Coordinate& successor_coordinate)
+bool RBFS::IsGenerated(const CellId cell)
 {
-    return  CurrentMap->IsValidCoordinate(successor_coordinate) &&
-            CurrentMap->IsPassableCoordinate(successor_coordinate) &&
-            !IsGenerated(successor_coordinate);
+    return Lookup.Contains(cell);
+}
+
+// RetainedMemory only, a cell is generated unless a path no costlier than the given g-value reached it before.
+// a successor left by a former expansion of root, which was since reached by a cheaper path and detached, is
+// generated again, even if rounding leaves its g-value unchanged
+bool RBFS::IsLegalSuccessor(const CellId root, const CellId successor, const double sum_of_weights)
+{
+    const RbfsNode* successor_node = Lookup.Find(successor);
+    return successor_node == nullptr || sum_of_weights < successor_node->SumOfWeights || successor_node->Parent == root;
+}
+
+bool RBFS::Prepare(const Agent& agent)
+{
+    if(!IsValidQuery(__PRETTY_FUNCTION__, agent))
+    {
+        return false;
+    }
+    if(Memory == RetainedMemory)
+    {
+        Lookup.Reset(CurrentMap->GetNumberOfRows(), CurrentMap->GetNumberOfColumns());
+    }
+    else
+    {
+        OnPath.assign(static_cast<std::size_t>(CurrentMap->GetNumberOfRows()) * CurrentMap->GetNumberOfColumns(), false);
+    }
+    Frames.clear();
+    MaxDepth = 0;
+    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
+    return true;
 }
 
 Path RBFS::Solve(const Agent& agent)
 {
-    if(CurrentMap == nullptr)
+    if(!Prepare(agent))
     {
-        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nullptr!\n");
         return {};
     }
-    Lookup.clear();
     const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
-    const double root_stored_value = H(src, dst);
-    Lookup[src] = {src, root_stored_value, root_stored_value, 0};
-    auto sol = Search(src ,root_stored_value, dst);
-    if(IsSolutionFound(sol))
+    // a goal outside of the component of the start is rejected without a search
+    if(CurrentMap->AreConnected(src, dst) && IsSolutionFound(Search(src, POSITIVE_INFINITY, dst)))
     {
         Path solution = ReconstructPath(agent);
         return solution;
@@ -57,131 +86,227 @@ bool RBFS::IsSolutionFound(const Solution& sol) const
     return get<STATUS_INDEX>(sol) == Succeed;
 }
 
-double RBFS::ExtractBound(const Solution& sol) const
-{
-    constexpr int BOUND_INDEX = 0;
-    return get<BOUND_INDEX>(sol);
-}
-
-void RBFS::Generate(RbfsNode& root_node, const Coordinate& successor_coordinate, const Coordinate& goal)
+template<typename Model>
+void RBFS::Generate(RbfsNode& root_node, RbfsNode& successor_node, const CellId successor,
+                    const Coordinate& successor_coordinate, const double successor_sum_of_weights, const Coordinate& goal,
+                    const Model& model)
 {
     NumberOfGeneratedNodes++;
-    // calculate static value(f) , sum of weights(g), stored value(F) for successor
-    const Coordinate& root_coordinate = root_node.MyCoordinate;
-    RbfsNode& successor_node = Lookup[successor_coordinate];
-    double successor_sum_of_weights = root_node.SumOfWeights + W(root_coordinate, successor_coordinate);
-    double successor_heuristic_estimation = H(successor_coordinate, goal);
+    // calculate static value(f) , stored value(F) for successor
+    double successor_heuristic_estimation = model.H(successor_coordinate, goal);
     double successor_static_value = successor_sum_of_weights + successor_heuristic_estimation;
-    successor_node = {successor_coordinate, root_coordinate, successor_static_value, successor_static_value, successor_sum_of_weights};
+    successor_node = {successor, root_node.Id, successor_static_value, successor_static_value, successor_sum_of_weights};
 
-    // add successor RbfsNode address to its parent successors vector
-    root_node.Successors.push_back(&successor_node);
+    root_node.AddSuccessor(&successor_node);
 }
 
-void RBFS::Expand(const Coordinate root_coordinate, const Coordinate& goal)
+template<typename Model>
+void RBFS::Expand(RbfsNode& root_node, const Coordinate& goal, const Model& model)
 {
-    RbfsNode& root_node = Lookup[root_coordinate];
     if(!IsNodeExpanded(root_node))
     {
         NumberOfExpandedNodes++;
-        for(const auto& direction : eight_principle_directions)
+        const CellId root = root_node.Id;
+        const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+        const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
+        for(unsigned int directions = CurrentMap->GetNeighborMask(root); directions != 0; directions &= directions - 1)
         {
+            const int i = std::countr_zero(directions);
+            const CellId successor = root + offsets[i];
+            const Coordinate& direction = eight_principle_directions[i];
             Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
                                                root_coordinate.GetColumn() + direction.GetColumn()};
-
-            if(IsLegalSuccessor(successor_coordinate))
+            const double successor_sum_of_weights = root_node.SumOfWeights + model.W(root_coordinate, successor_coordinate);
+            if(IsLegalSuccessor(root, successor, successor_sum_of_weights))
             {
-                Generate(root_node, successor_coordinate, goal);
+                if(IsGenerated(successor))
+                {
+                    // reached by a cheaper path. a node of the current path is never reached so, as weights are
+                    // positive. its former successors are generated again in turn once it is expanded again
+                    RbfsNode& successor_node = Lookup[successor];
+                    Lookup[successor_node.Parent].RemoveSuccessor(&successor_node);
+                }
+                Generate(root_node, Lookup[successor], successor, successor_coordinate, successor_sum_of_weights, goal, model);
             }
         }
     }
     else
     {   // apply restore action
-        for(RbfsNode* successor : root_node.Successors)
+        for(std::size_t i = 0; i < root_node.NumberOfSuccessors; i++)
         {
+            RbfsNode* successor = root_node.Successors[i];
             successor->StoredValue = std::max(root_node.StoredValue, successor->StaticValue);
         }
     }
 
-    std::sort(root_node.Successors.begin(), root_node.Successors.end(), RbfsNode::RbfsNodeComparator);
+    root_node.SortSuccessors(TieOrder);
 }
 
-RBFS::Solution RBFS::Search(const Coordinate root_coordinate, const double bound, const Coordinate& goal)
+template<typename Model>
+void RBFS::ExpandLinear(RbfsNode& root_node, const Coordinate& goal, const Model& model)
 {
-    if(IsGoal(root_coordinate, goal))
+    // successors are generated anew on every visit, into the slots of the frame's depth
+    NumberOfExpandedNodes++;
+    const CellId root = root_node.Id;
+    const Coordinate root_coordinate = CurrentMap->GetCoordinate(root);
+    const std::array<std::int32_t, 8>& offsets = CurrentMap->GetNeighborOffsets();
+    Successors& successors = Children[Frames.size()];
+    const bool is_restored = IsNodeExpanded(root_node);
+    root_node.NumberOfSuccessors = 0;
+    for(unsigned int directions = CurrentMap->GetNeighborMask(root); directions != 0; directions &= directions - 1)
     {
-        return {bound, Succeed};
+        const int i = std::countr_zero(directions);
+        const CellId successor = root + offsets[i];
+        if(!OnPath[successor])
+        {
+            const Coordinate& direction = eight_principle_directions[i];
+            Coordinate successor_coordinate = {root_coordinate.GetRow() + direction.GetRow(),
+                                               root_coordinate.GetColumn() + direction.GetColumn()};
+            RbfsNode& successor_node = successors[root_node.NumberOfSuccessors];
+            Generate(root_node, successor_node, successor, successor_coordinate,
+                     root_node.SumOfWeights + model.W(root_coordinate, successor_coordinate), goal, model);
+            if(is_restored)
+            {
+                // apply restore action, root was collapsed before with a stored value above its static value
+                successor_node.StoredValue = std::max(root_node.StoredValue, successor_node.StaticValue);
+            }
+        }
     }
 
-    NumberOfPopOperations++;
+    root_node.SortSuccessors(TieOrder);
+}
 
-    Expand(root_coordinate, goal);
-    RbfsNode& root_node = Lookup[root_coordinate];
-    std::vector<RbfsNode*>& successors = root_node.Successors;
-    auto number_of_successors = successors.size();
+template<typename Model>
+void RBFS::Push(RbfsNode& root_node, const double bound, const Coordinate& goal, const Model& model)
+{
+    NumberOfPopOperations++;
+    if(Memory == RetainedMemory)
+    {
+        Expand(root_node, goal, model);
+    }
+    else
+    {
+        // slots are only added, so the successors of shallower frames never move
+        if(Children.size() <= Frames.size())
+        {
+            Children.emplace_back();
+        }
+        OnPath[root_node.Id] = true;
+        ExpandLinear(root_node, goal, model);
+    }
+    Frames.push_back({&root_node, bound});
+    MaxDepth = std::max(MaxDepth, Frames.size());
+}
 
-    if(number_of_successors == 0)
+void RBFS::Pop(void)
+{
+    if(Memory == LinearMemory)
     {
-        return {POSITIVE_INFINITY, Failed};
+        OnPath[Frames.back().Node->Id] = false;
     }
+    Frames.pop_back();
+}
 
-    RbfsNode* best_successor = successors.at(0);
-    double best_successor_stored_value = best_successor->StoredValue;
+template<typename Model>
+RBFS::Solution RBFS::Search(const Coordinate root_coordinate, const double bound, const Coordinate& goal, const Model& model)
+{
+    const CellId root = CurrentMap->GetCellId(root_coordinate), goal_cell = CurrentMap->GetCellId(goal);
+    const double root_stored_value = model.H(root_coordinate, goal);
+    RbfsNode& root_node = (Memory == RetainedMemory) ? Lookup[root] : Root;
+    root_node = {root, root_stored_value, root_stored_value, 0};
+    if(root == goal_cell)
+    {
+        return {bound, Succeed};
+    }
 
-    while(best_successor_stored_value <= bound && best_successor_stored_value < POSITIVE_INFINITY)
+    /*
+     * Frame i stands for the recursive call on the i-th node of the current path. A call descends into the best
+     * successor of its node, bounded by the stored value of the second best, as long as the best one's stored value
+     * is within the call's bound. Otherwise the call returns that stored value, which its caller applies as a
+     * collapse action onto its own best successor.
+     */
+    Push(root_node, bound, goal, model);
+    while(true)
     {
-        const double alternative = (number_of_successors == 1) ? POSITIVE_INFINITY : successors.at(1)->StoredValue;
-        auto solution = Search(best_successor->MyCoordinate, std::min(bound, alternative), goal);
-        // solution is found and cross through best_successor RbfsNode.
-        if(IsSolutionFound(solution))
+        const Frame& frame = Frames.back();
+        RbfsNode& node = *frame.Node;
+        RbfsNode* best_successor = (node.NumberOfSuccessors == 0) ? nullptr : node.Successors[0];
+        const double best_successor_stored_value = (best_successor == nullptr) ? POSITIVE_INFINITY : best_successor->StoredValue;
+
+        if(best_successor_stored_value > frame.Bound || best_successor_stored_value >= POSITIVE_INFINITY)
+        {
+            Pop();
+            if(Frames.empty())
+            {
+                return {best_successor_stored_value, Failed};
+            }
+            // apply collapse action
+            // search for a solution in a different branch
+            RbfsNode& parent = *Frames.back().Node;
+            parent.Successors[0]->StoredValue = best_successor_stored_value;
+            parent.ReorderBestSuccessor(TieOrder);
+            continue;
+        }
+
+        const double alternative = (node.NumberOfSuccessors == 1) ? POSITIVE_INFINITY : node.Successors[1]->StoredValue;
+        // under DeepTieBreak the best successor may store a value slightly above the alternative, which it ties with.
+        // it is still given a bound of its own stored value, or it would collapse back unchanged forever
+        const double successor_bound = std::min(frame.Bound, std::max(alternative, best_successor_stored_value));
+        // solution is found and cross through the nodes of all frames
+        if(best_successor->Id == goal_cell)
         {
-            return solution;
+            return {successor_bound, Succeed};
         }
-        // apply collapse action
-        // search for a solution in a different branch
-        best_successor->StoredValue = ExtractBound(solution);
-        std::sort(successors.begin(), successors.end(), RbfsNode::RbfsNodeComparator);
-        best_successor = successors.at(0);
-        best_successor_stored_value = best_successor->StoredValue;
+        Push(*best_successor, successor_bound, goal, model);
     }
-    return {best_successor_stored_value, Failed};
+}
+
+RBFS::Solution RBFS::Search(const Coordinate root_coordinate, const double bound, const Coordinate& goal)
+{
+    return WithCostModel([&](const auto& model)
+    {
+        return Search(root_coordinate, bound, goal, model);
+    });
 }
 
 Path RBFS::ReconstructPath(const Agent& agent)
 {
-    Coordinate current = Lookup[agent.GetGoalCoordinate()].MyCoordinate;
-    const Coordinate& source = Lookup[agent.GetStartCoordinate()].MyCoordinate;
+    // the frames hold the path from the start up to the goal's predecessor
     Path solution;
-
-    while(current != source)
+    solution.reserve(Frames.size() + 1);
+    for(const Frame& frame : Frames)
     {
-        solution.emplace_back(current);
-        current = Lookup[current].Parent;
+        solution.push_back(CurrentMap->GetCoordinate(frame.Node->Id));
     }
-
-    solution.push_back(source);
-    std::reverse(solution.begin(), solution.end());
+    solution.push_back(agent.GetGoalCoordinate());
 
     return solution;
 }
 
+std::size_t RBFS::GetMemoryUsage(void) const
+{
+    const std::size_t stack_memory = MaxDepth * sizeof(Frame);
+    if(Memory == RetainedMemory)
+    {
+        return Lookup.GetMemoryUsage() + stack_memory;
+    }
+    return sizeof(RbfsNode) + OnPath.size() / 8 + MaxDepth * sizeof(Successors) + stack_memory;
+}
+
 Report RBFS::SolveFullReport(const Agent& agent)
 {
-    if(CurrentMap == nullptr)
+    if(!Prepare(agent))
     {
-        DisplayMessage(Red, __PRETTY_FUNCTION__ , ": CurrentMap is nullptr!\n");
         return {};
     }
-    Lookup.clear();
-    NumberOfExpandedNodes = NumberOfGeneratedNodes = NumberOfPopOperations = MaxHeapSize = 0;
     const Coordinate src = agent.GetStartCoordinate(), dst = agent.GetGoalCoordinate();
-    const double root_stored_value = H(src, dst);
-    Lookup[src] = {src, root_stored_value, root_stored_value, 0};
-    auto sol = Search(src ,POSITIVE_INFINITY, dst);
     Path solution;
-    if(IsSolutionFound(sol))
+    if(CurrentMap->AreConnected(src, dst) && IsSolutionFound(Search(src, POSITIVE_INFINITY, dst)))
     {
         solution = ReconstructPath(agent);
     }
-    return {solution, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize};
-}
\ No newline at end of file
+    PeakMemory = GetMemoryUsage();
+    const double bound = solution.empty() ? 0.0 : 1.0;
+    return {solution, agent, NumberOfExpandedNodes, NumberOfGeneratedNodes, NumberOfPopOperations, MaxHeapSize, PeakMemory, 0,
+            bound};
+}
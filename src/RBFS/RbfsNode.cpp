@@ -1,75 +1,91 @@
 #include "../../include/RBFS/RbfsNode.h"
 #include <cmath>
-const double POSITIVE_INFINITY = std::numeric_limits<double>::max();
+#include <type_traits>
 
-RbfsNode::RbfsNode():   MyCoordinate(), Parent(), StaticValue(POSITIVE_INFINITY),
-                StoredValue(POSITIVE_INFINITY), SumOfWeights(0), Successors() {}
+// nodes are stored per map cell and copied as plain memory
+static_assert(std::is_trivially_copyable_v<RbfsNode>);
+const double POSITIVE_INFINITY = std::numeric_limits<double>::max();
 
-RbfsNode::RbfsNode(const Coordinate& coordinate):
-    MyCoordinate(coordinate), Parent(), StaticValue(POSITIVE_INFINITY),
-    StoredValue(POSITIVE_INFINITY), SumOfWeights(0),Successors() {}
+RbfsNode::RbfsNode():   Id(0), Parent(0), StaticValue(POSITIVE_INFINITY),
+                StoredValue(POSITIVE_INFINITY), SumOfWeights(0), Successors(), NumberOfSuccessors(0) {}
 
-RbfsNode::RbfsNode(const Coordinate& coordinate, const double f, const double F, const double g):
-    MyCoordinate(coordinate), Parent(), StaticValue(f), StoredValue(F), SumOfWeights(g), Successors(){}
+RbfsNode::RbfsNode(const CellId id):
+    Id(id), Parent(id), StaticValue(POSITIVE_INFINITY),
+    StoredValue(POSITIVE_INFINITY), SumOfWeights(0), Successors(), NumberOfSuccessors(0) {}
 
-RbfsNode::RbfsNode(const Coordinate& coordinate, const Coordinate& parent, const double f, const double F, const double g):
-        MyCoordinate(coordinate), Parent(parent), StaticValue(f), StoredValue(F), SumOfWeights(g),Successors() {}
+RbfsNode::RbfsNode(const CellId id, const double f, const double F, const double g):
+    Id(id), Parent(id), StaticValue(f), StoredValue(F), SumOfWeights(g), Successors(), NumberOfSuccessors(0) {}
 
-RbfsNode::RbfsNode(const RbfsNode& other):
-    MyCoordinate(other.MyCoordinate), Parent(other.Parent), StaticValue(other.StaticValue),
-    StoredValue(other.StoredValue), SumOfWeights(other.SumOfWeights), Successors(other.Successors){}
+RbfsNode::RbfsNode(const CellId id, const CellId parent, const double f, const double F, const double g):
+        Id(id), Parent(parent), StaticValue(f), StoredValue(F), SumOfWeights(g), Successors(), NumberOfSuccessors(0) {}
 
+std::ostream& operator << (std::ostream& out, const RbfsNode& RbfsNode)
+{
+    return out << '<' << RbfsNode.Id << ", f=" << RbfsNode.StaticValue << ", F=" << RbfsNode.StoredValue << ", g=" << RbfsNode.SumOfWeights << '>';
+}
 
-RbfsNode::RbfsNode(RbfsNode&& other) noexcept: MyCoordinate(std::forward<Coordinate>(other.MyCoordinate)),
-    Parent(std::forward<Coordinate>(other.Parent)), StaticValue(std::forward<double>(other.StaticValue)),
-    StoredValue(std::forward<double>(other.StoredValue)),SumOfWeights(std::forward<double>(other.SumOfWeights)),
-    Successors(std::forward<std::vector<RbfsNode*>>(other.Successors)){}
+bool RbfsNode::operator==(const RbfsNode &other) const
+{
+    return Id == other.Id;
+}
 
-std::ostream& operator << (std::ostream& out, const RbfsNode& RbfsNode)
+bool RbfsNode::operator!=(const RbfsNode &other) const
 {
-    return out << '<' << RbfsNode.MyCoordinate << ", f=" << RbfsNode.StaticValue << ", F=" << RbfsNode.StoredValue << ", g=" << RbfsNode.SumOfWeights << '>';
+    return !(*this == other);
 }
 
-RbfsNode& RbfsNode::operator=(RbfsNode&& other) noexcept
+void RbfsNode::AddSuccessor(RbfsNode* successor)
 {
-    if(this != &other)
-    {
-        MyCoordinate = std::forward<Coordinate>(other.MyCoordinate);
-        Parent = std::forward<Coordinate>(other.Parent);
-        StaticValue = std::forward<double>(other.StaticValue);
-        StoredValue = std::forward<double>(other.StoredValue);
-        SumOfWeights = std::forward<double>(other.SumOfWeights);
-        Successors = std::forward<std::vector<RbfsNode*>>(other.Successors);
-    }
-    return *this;
+    Successors[NumberOfSuccessors++] = successor;
 }
 
-RbfsNode& RbfsNode::operator=(const RbfsNode& other)
+void RbfsNode::RemoveSuccessor(const RbfsNode* successor)
 {
-    if(this != &other)
+    std::size_t i = 0;
+    for(; i < NumberOfSuccessors && Successors[i] != successor; i++);
+    if(i == NumberOfSuccessors)
+    {
+        return;
+    }
+    for(NumberOfSuccessors--; i < NumberOfSuccessors; i++)
     {
-        MyCoordinate = other.MyCoordinate;
-        Parent = other.Parent;
-        StaticValue = other.StaticValue;
-        StoredValue = other.StoredValue;
-        SumOfWeights = other.SumOfWeights;
-        Successors = other.Successors;
+        Successors[i] = Successors[i + 1];
     }
-    return *this;
 }
 
-bool RbfsNode::operator==(const RbfsNode &other) const
+void RbfsNode::SortSuccessors(const TieBreak tie_break)
 {
-    return MyCoordinate == other.MyCoordinate;
+    // insertion sort, at most 8 successors which are usually close to order already
+    for(std::size_t i = 1; i < NumberOfSuccessors; i++)
+    {
+        RbfsNode* successor = Successors[i];
+        std::size_t j = i;
+        for(; j > 0 && RbfsNodeComparator(successor, Successors[j - 1], tie_break); j--)
+        {
+            Successors[j] = Successors[j - 1];
+        }
+        Successors[j] = successor;
+    }
 }
 
-bool RbfsNode::operator!=(const RbfsNode &other) const
+void RbfsNode::ReorderBestSuccessor(const TieBreak tie_break)
 {
-    return !(*this == other);
+    RbfsNode* best_successor = Successors[0];
+    std::size_t i = 0;
+    for(; i + 1 < NumberOfSuccessors && RbfsNodeComparator(Successors[i + 1], best_successor, tie_break); i++)
+    {
+        Successors[i] = Successors[i + 1];
+    }
+    Successors[i] = best_successor;
 }
 
-bool RbfsNode::RbfsNodeComparator(const RbfsNode* n1, const RbfsNode* n2)
+bool RbfsNode::RbfsNodeComparator(const RbfsNode* n1, const RbfsNode* n2, const TieBreak tie_break)
 {
+    if(tie_break == DeepTieBreak)
+    {
+        return IsTie(n1->StoredValue, n2->StoredValue) ? (n1->SumOfWeights > n2->SumOfWeights) :
+               (n1->StoredValue < n2->StoredValue);
+    }
     return (n1->StoredValue == n2->StoredValue) ? (n1->SumOfWeights < n2->SumOfWeights) :
-    (n1->StoredValue < n2->StoredValue);
+           (n1->StoredValue < n2->StoredValue);
 }
\ No newline at end of file
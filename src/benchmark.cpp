@@ -0,0 +1,238 @@
+#include "../include/Common/Planner.h"
+#include "../include/Common/Printer.h"
+#include "../include/Benchmark/Benchmark.h"
+#include "../include/AStar/AStar.h"
+#include "../include/PEAStar/PEAStar.h"
+#include "../include/RBFS/RBFS.h"
+#include "../include/JPS/JPS.h"
+#include "../include/MM/MM.h"
+#include "../include/DStarLite/DStarLite.h"
+#include "../include/BoundedAStar/BoundedAStar.h"
+#include "../include/ARAStar/ARAStar.h"
+#include <cstdlib> // exit
+#include <cstring> // strcmp()
+#include <fstream>
+#include <string>
+#include <memory> // unique_ptr
+#include <optional>
+
+struct BenchmarkArguments
+{
+    const char* MapPath = nullptr;
+    const char* ScenarioPath = nullptr;
+    std::string Solver = "astar";
+    Heuristic HeuristicType = Octile;
+    Weight WeightType = OctileWeight;
+    double Suboptimality = 1.05; // w of the bounded-suboptimal solvers
+    double TimeBudget = 20; // of the anytime solver per query, in milliseconds
+    MemoryMode Memory = RetainedMemory; // of rbfs
+    std::size_t NumberOfWarmups = 1, NumberOfRepetitions = 5;
+    bool IsJson = false;
+    const char* OutputPath = nullptr; // summaries, standard output if missing
+    const char* QueriesPath = nullptr; // per-query records, not written if missing
+};
+
+static void DisplayUsage(void)
+{
+    DisplayMessage(Red, "Usage: benchmark <map> <scenario>\n"
+                        "    [--solver astar|peastar|epeastar|rbfs|jps|mm|dstar|wastar|focal|ees|arastar] [--suboptimality w]\n"
+                        "    [--budget ms] [--memory retained|linear]\n"
+                        "    [--heuristic euclidean|manhattan|chebyshev|octile|differential] [--weight unit|octile]\n"
+                        "    [--warmup N] [--repetitions N] [--format csv|json] [--output path] [--queries path]\n");
+}
+
+template<typename T>
+static std::optional<T> ParseName(const char* name, std::initializer_list<std::pair<const char*, T>> values)
+{
+    for(const auto& [value_name, value] : values)
+    {
+        if(std::strcmp(name, value_name) == 0)
+        {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+static std::optional<BenchmarkArguments> ParseArguments(int argc, char** const argv)
+{
+    if(argc < 3)
+    {
+        return std::nullopt;
+    }
+    if(argc % 2 == 0)
+    {
+        DisplayMessage(Red, "Option ", argv[argc - 1], " lacks a value\n");
+        return std::nullopt;
+    }
+    BenchmarkArguments arguments;
+    arguments.MapPath = argv[1];
+    arguments.ScenarioPath = argv[2];
+    for(int i = 3; i + 1 < argc; i += 2)
+    {
+        const std::string option = argv[i];
+        const char* const value = argv[i + 1];
+        std::optional<Heuristic> heuristic;
+        std::optional<Weight> weight;
+        std::optional<bool> is_json;
+        std::optional<MemoryMode> memory;
+        if(option == "--solver")
+        {
+            arguments.Solver = value;
+        }
+        else if(option == "--heuristic" && (heuristic = ParseName<Heuristic>(value, {{"euclidean", Euclidean},
+                {"manhattan", Manhattan}, {"chebyshev", Chebyshev}, {"octile", Octile}, {"differential", Differential}})))
+        {
+            arguments.HeuristicType = *heuristic;
+        }
+        else if(option == "--weight" && (weight = ParseName<Weight>(value, {{"unit", UnitWeight}, {"octile", OctileWeight}})))
+        {
+            arguments.WeightType = *weight;
+        }
+        else if(option == "--memory" && (memory = ParseName<MemoryMode>(value, {{"retained", RetainedMemory},
+                {"linear", LinearMemory}})))
+        {
+            arguments.Memory = *memory;
+        }
+        else if(option == "--format" && (is_json = ParseName<bool>(value, {{"csv", false}, {"json", true}})))
+        {
+            arguments.IsJson = *is_json;
+        }
+        else if(option == "--suboptimality")
+        {
+            arguments.Suboptimality = std::strtod(value, nullptr);
+        }
+        else if(option == "--budget")
+        {
+            arguments.TimeBudget = std::strtod(value, nullptr);
+        }
+        else if(option == "--warmup")
+        {
+            arguments.NumberOfWarmups = std::strtoul(value, nullptr, 10);
+        }
+        else if(option == "--repetitions")
+        {
+            arguments.NumberOfRepetitions = std::strtoul(value, nullptr, 10);
+        }
+        else if(option == "--output")
+        {
+            arguments.OutputPath = value;
+        }
+        else if(option == "--queries")
+        {
+            arguments.QueriesPath = value;
+        }
+        else
+        {
+            DisplayMessage(Red, "Unknown option or value: ", option, ' ', value, '\n');
+            return std::nullopt;
+        }
+    }
+    return arguments;
+}
+
+static std::unique_ptr<ISingleAgentPathFinder> MakeSolver(const BenchmarkArguments& arguments)
+{
+    const Heuristic heuristic = arguments.HeuristicType;
+    const Weight weight = arguments.WeightType;
+    if(arguments.Solver == "astar")
+    {
+        return std::make_unique<AStar>(heuristic, weight);
+    }
+    if(arguments.Solver == "peastar")
+    {
+        return std::make_unique<PEAStar>(heuristic, weight);
+    }
+    if(arguments.Solver == "epeastar")
+    {
+        auto solver = std::make_unique<PEAStar>(heuristic, weight);
+        solver->SetExpansionMode(EnhancedPartialExpansion);
+        return solver;
+    }
+    if(arguments.Solver == "rbfs")
+    {
+        auto solver = std::make_unique<RBFS>(heuristic, weight);
+        solver->SetMemoryMode(arguments.Memory);
+        return solver;
+    }
+    if(arguments.Solver == "jps")
+    {
+        return std::make_unique<JPS>(heuristic);
+    }
+    if(arguments.Solver == "mm")
+    {
+        return std::make_unique<MM>(heuristic, weight);
+    }
+    if(arguments.Solver == "dstar")
+    {
+        return std::make_unique<DStarLite>(heuristic, weight);
+    }
+    if(arguments.Solver == "arastar")
+    {
+        auto solver = std::make_unique<ARAStar>(heuristic, weight);
+        solver->SetTimeBudget(std::chrono::duration_cast<ARAStar::Clock::duration>(
+            std::chrono::duration<double, std::milli>(arguments.TimeBudget)));
+        return solver;
+    }
+    const std::optional<SuboptimalSearch> mode = ParseName<SuboptimalSearch>(arguments.Solver.c_str(),
+        {{"wastar", WeightedAStarSearch}, {"focal", FocalSearch}, {"ees", ExplicitEstimationSearch}});
+    if(mode)
+    {
+        auto solver = std::make_unique<BoundedAStar>(heuristic, weight);
+        solver->SetMode(*mode);
+        solver->SetSuboptimality(arguments.Suboptimality);
+        return solver;
+    }
+    DisplayMessage(Red, "Unknown solver ", arguments.Solver, '\n');
+    return nullptr;
+}
+
+// diagnostics are printed to the standard output, hence --output keeps the results apart from them
+int main(int argc, char** const argv)
+{
+    const std::optional<BenchmarkArguments> arguments = ParseArguments(argc, argv);
+    if(!arguments)
+    {
+        DisplayUsage();
+        exit(EXIT_FAILURE);
+    }
+    std::unique_ptr<ISingleAgentPathFinder> solver = MakeSolver(*arguments);
+    if(solver == nullptr)
+    {
+        exit(EXIT_FAILURE);
+    }
+    Planner planner(arguments->MapPath, arguments->ScenarioPath);
+    if(arguments->HeuristicType == Differential)
+    {
+        planner.PrepareDifferentialHeuristic(arguments->WeightType);
+    }
+    // JPS moves under octile weight regardless of the requested one
+    const Weight weight = (arguments->Solver == "jps") ? OctileWeight : arguments->WeightType;
+    Benchmark benchmark(*solver, planner.GetMap(), weight, arguments->NumberOfWarmups, arguments->NumberOfRepetitions);
+    benchmark.Run(planner.GetAgents());
+
+    if(arguments->QueriesPath != nullptr)
+    {
+        std::ofstream queries(arguments->QueriesPath);
+        arguments->IsJson ? benchmark.WriteQueriesJson(queries) : benchmark.WriteQueriesCsv(queries);
+        if(!queries)
+        {
+            DisplayMessage(Red, "Failed to write ", arguments->QueriesPath, '\n');
+            exit(EXIT_FAILURE);
+        }
+    }
+    std::ofstream output;
+    if(arguments->OutputPath != nullptr)
+    {
+        output.open(arguments->OutputPath);
+    }
+    std::ostream& out = (arguments->OutputPath != nullptr) ? output : std::cout;
+    arguments->IsJson ? benchmark.WriteSummariesJson(out) : benchmark.WriteSummariesCsv(out);
+    // exit() does not destroy the stream, which would flush it
+    if(!out.flush())
+    {
+        DisplayMessage(Red, "Failed to write the summaries\n");
+        exit(EXIT_FAILURE);
+    }
+    exit(EXIT_SUCCESS);
+}
@@ -3,12 +3,20 @@
 #include "../include/AStar/AStar.h"
 #include "../include/RBFS/RBFS.h"
 #include "../include/PEAStar/PEAStar.h"
+#include "../include/DStarLite/DStarLite.h"
 #include "../include/Common/Printer.h"
+#include "../include/MAPF/PrioritizedPlanning.h"
+#include "../include/MAPF/CBS.h"
 
 void RunPEAStar(Planner&);
 void RunAStar(Planner&);
 void RunRBFS(Planner&);
+void RunAStarInParallel(Planner&);
+void RunDStarLite(Planner&);
 void CompareAStarToRbfs(Planner&);
+void RunPrioritizedPlanning(Planner&, const std::size_t);
+void RunCBS(Planner&, const std::size_t);
+void RunCBSInParallel(Planner&, const std::size_t);
 
 int main(int argc, char** const argv)
 {
@@ -44,6 +52,40 @@ void RunAStar(Planner& planner)
     planner.PlanAllScenarios();
 }
 
+void RunAStarInParallel(Planner& planner)
+{
+    // each worker thread plans with its own A* instance
+    planner.PlanAllScenarios([]{ return std::make_unique<AStar>(Manhattan); });
+}
+
+void RunDStarLite(Planner& planner)
+{
+    // values are reused between consecutive agents with the same goal
+    DStarLite dstar_lite(Octile, OctileWeight);
+    planner.SetSingleAgentPathFinder(&dstar_lite);
+    planner.PlanAllScenarios();
+}
+
+void RunPrioritizedPlanning(Planner& planner, const std::size_t number_of_agents)
+{
+    PrioritizedPlanning prioritized_planning;
+    planner.PlanTogether(prioritized_planning, number_of_agents);
+}
+
+void RunCBS(Planner& planner, const std::size_t number_of_agents)
+{
+    CBS cbs;
+    planner.PlanTogether(cbs, number_of_agents);
+}
+
+void RunCBSInParallel(Planner& planner, const std::size_t number_of_agents)
+{
+    // constraint tree nodes are expanded by all cores
+    CBS cbs;
+    cbs.SetNumberOfThreads();
+    planner.PlanTogether(cbs, number_of_agents);
+}
+
 void CompareAStarToRbfs(Planner& planner)
 {
     AStar astar(Manhattan);
@@ -63,7 +105,7 @@ void CompareAStarToRbfs(Planner& planner)
 
             if(get<PATH>(astar_report).size() != get<PATH>(rbfs_report).size())
             {
-                Map& map = planner.GetMap();
+                const Map& map = planner.GetMap();
                 wrong_answer++;
                 DisplayMessage(Red, "Failure!!!!\nA* report is: \n");
                 DisplayReport(astar_report);